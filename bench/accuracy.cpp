@@ -0,0 +1,93 @@
+// Accuracy checks for the approximations the module relies on, each against
+// its exact reference and the bound documented with it. Prints one line per
+// check and exits non-zero if any is out of bounds. Run with `make check`.
+#include "DriftOscillator.hpp"
+#include "OpenSimplexNoise.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+
+static const int64_t NOISE_SEED_BASE = 3518;
+static const float ORBIT_Z = 10.f;
+
+static int failures = 0;
+
+static void report(const char* name, double maxError, double tolerance) {
+	bool ok = maxError <= tolerance;
+	if (!ok) failures++;
+	printf("%-48s max error %.3g (tolerance %.2g)  %s\n", name, maxError, tolerance, ok ? "ok" : "FAILED");
+}
+
+// EvaluateBatch against the scalar float and double engines, on orbits over
+// the module's whole Base 1-10 / Range 2^1-2^10 domain
+static void checkNoiseBatch(int64_t seed, double& maxFloat, double& maxDouble) {
+	const int POINTS = 64;
+	float x[POINTS], y[POINTS], out[POINTS];
+	OpenSimplexNoiseF noise(seed);
+	OpenSimplexNoise reference(seed);
+	for (float base=1.f;base<=10.f;base+=0.25f) {
+		for (float range=1.f;range<=10.f;range+=0.25f) {
+			float radius = std::pow(2.f, range) / 50.f;
+			for (int i=0;i<POINTS;i++) {
+				float ang = 2.f * (float)M_PI * i / POINTS;
+				x[i] = base + std::sin(ang) * radius;
+				y[i] = base + std::cos(ang) * radius;
+			}
+			noise.EvaluateBatch(x, y, ORBIT_Z, out, POINTS);
+			for (int i=0;i<POINTS;i++) {
+				maxFloat = std::max(maxFloat, (double)std::fabs(out[i] - noise.Evaluate(x[i], y[i], ORBIT_Z)));
+				maxDouble = std::max(maxDouble, std::fabs(out[i] - reference.Evaluate((double)x[i], (double)y[i], (double)ORBIT_Z)));
+			}
+		}
+	}
+}
+
+// DriftOscillator lookups over the 0-4*PI phases drift uses, and rows of up
+// to 16 offsets at every Drift Type spacing, against std::sin
+static void checkDrift() {
+	const DriftOscillator& osc = DriftOscillator::get();
+	double maxSin = 0.0, maxRow = 0.0;
+	const int PHASES = 200000;
+	for (int i=0;i<=PHASES;i++) {
+		float phase = (float)(4.0 * M_PI * i / PHASES);
+		maxSin = std::max(maxSin, std::fabs(osc.sin(phase) - std::sin((double)phase)));
+	}
+	float out[16];
+	for (int i=0;i<=2000;i++) {
+		float phase = (float)(2.0 * M_PI * i / 2000);
+		for (int steps=2;steps<=16;steps++) {
+			for (float spacing : {(float)(2.0 * M_PI / steps), (float)(M_PI / steps)}) {
+				osc.offsets(phase, spacing, steps, out);
+				for (int r=0;r<steps;r++) {
+					maxRow = std::max(maxRow, std::fabs(out[r] - std::sin((double)phase + r * (double)spacing)));
+				}
+			}
+		}
+	}
+	// interpolating between table entries h apart is within h^2/8 of sin;
+	// the rest covers float rounding of the phase, the index and the rows
+	const double h = 2.0 * M_PI / DriftOscillator::TABLE_SIZE;
+	const double interpolation = h * h / 8.0;
+	report("drift: DriftOscillator::sin vs std::sin", maxSin, interpolation + 1.3e-6);
+	report("drift: DriftOscillator::offsets vs std::sin", maxRow, interpolation + 2.3e-6);
+}
+
+int main() {
+	// Seed 0 and a few others, as the Seed param picks them
+	double maxFloat = 0.0, maxDouble = 0.0;
+	for (int seed : {0, 1, 17, 999}) {
+		checkNoiseBatch(NOISE_SEED_BASE + seed, maxFloat, maxDouble);
+	}
+	report("noise: EvaluateBatch vs float Evaluate", maxFloat, 1e-5);
+	report("noise: EvaluateBatch vs double Evaluate", maxDouble, 1.1e-4);
+	checkDrift();
+
+	if (failures) {
+		printf("%d check(s) failed\n", failures);
+		return 1;
+	}
+	printf("all checks passed\n");
+	return 0;
+}
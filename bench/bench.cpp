@@ -0,0 +1,109 @@
+// Headless benchmark for ORBsqVi::process(). Builds the module against the
+// Rack mock in bench/rack_mock and drives it through scripted scenarios,
+// reporting audio-thread cost per sample, block percentiles, step
+// regenerations per (simulated) second and CPU time spent on the sequence
+// worker. Run with `make bench` from the plugin root.
+//
+//   bench [--seconds S] [--scenario NAME]
+#include "../src/ORBsqVi.cpp"
+#include "../src/ORBsqViExpander.cpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include "scenarios.hpp"
+
+Plugin* pluginInstance;
+
+static double cpuSeconds(clockid_t clock) {
+	timespec ts;
+	clock_gettime(clock, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double percentile(std::vector<double>& v, double p) {
+	size_t i = std::min(v.size() - 1, (size_t)(p * v.size()));
+	std::nth_element(v.begin(), v.begin() + i, v.end());
+	return v[i];
+}
+
+static void run(const Scenario& s, float seconds) {
+	ORBsqVi* m = new ORBsqVi();
+	Module::SampleRateChangeEvent e;
+	e.sampleRate = SAMPLE_RATE;
+	e.sampleTime = 1.f / SAMPLE_RATE;
+	m->onSampleRateChange(e);
+	s.setup(m);
+
+	Module::ProcessArgs args;
+	args.sampleRate = SAMPLE_RATE;
+	args.sampleTime = 1.f / SAMPLE_RATE;
+	args.frame = 0;
+
+	int64_t frames = (int64_t)(seconds * SAMPLE_RATE);
+	int64_t blocks = frames / BLOCK_SIZE;
+	std::vector<double> blockNs;
+	blockNs.reserve(blocks);
+	uint64_t regens = 0;
+
+	// let the worker produce the first sequence before timing starts
+	for (int i=0;i<BLOCK_SIZE;i++) m->process(args);
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	m->regenCount.exchange(0);
+
+	double cpu0 = cpuSeconds(CLOCK_PROCESS_CPUTIME_ID);
+	double audio0 = cpuSeconds(CLOCK_THREAD_CPUTIME_ID);
+	auto wall0 = std::chrono::steady_clock::now();
+	for (int64_t b=0;b<blocks;b++) {
+		auto t0 = std::chrono::steady_clock::now();
+		for (int i=0;i<BLOCK_SIZE;i++) {
+			s.drive(m, args.frame);
+			m->process(args);
+			args.frame++;
+		}
+		auto t1 = std::chrono::steady_clock::now();
+		blockNs.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count() / BLOCK_SIZE);
+		regens += m->regenCount.exchange(0);
+	}
+	double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall0).count();
+	double audioCpu = cpuSeconds(CLOCK_THREAD_CPUTIME_ID) - audio0;
+	double workerCpu = cpuSeconds(CLOCK_PROCESS_CPUTIME_ID) - cpu0 - audioCpu;
+
+	printf("%-14s %9.1f %9.1f %9.1f %9.1f %9.1f %10.1f  %s\n", s.name,
+		wall * 1e9 / (blocks * BLOCK_SIZE),
+		percentile(blockNs, 0.5), percentile(blockNs, 0.99), percentile(blockNs, 1.0),
+		regens / seconds, std::max(0.0, workerCpu) * 1e3, s.description);
+	delete m;
+}
+
+int main(int argc, char** argv) {
+	float seconds = 10.f;
+	const char* only = NULL;
+	for (int i=1;i<argc;i++) {
+		if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+			seconds = std::max(0.1f, (float)atof(argv[++i]));
+		} else if (!strcmp(argv[i], "--scenario") && i + 1 < argc) {
+			only = argv[++i];
+		} else {
+			fprintf(stderr, "usage: %s [--seconds S] [--scenario NAME]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	printf("%.1f s of audio per scenario at %.0f Hz, %d-sample blocks; ns are per sample\n", seconds, SAMPLE_RATE, BLOCK_SIZE);
+	printf("%-14s %9s %9s %9s %9s %9s %10s\n", "scenario", "mean ns", "p50", "p99", "max", "regen/s", "worker ms");
+	if (only) {
+		const Scenario* s = findScenario(only);
+		if (!s) {
+			fprintf(stderr, "unknown scenario %s\n", only);
+			return 1;
+		}
+		run(*s, seconds);
+		return 0;
+	}
+	for (const Scenario& s : scenarios) {
+		run(s, seconds);
+	}
+	return 0;
+}
@@ -0,0 +1,53 @@
+// Checks of the module itself that need no recorded trace: situations that
+// once read or wrote outside the module's buffers. Prints one line per check
+// and exits non-zero if any fails. Run with `make check`.
+#include "../src/ORBsqVi.cpp"
+#include "../src/ORBsqViExpander.cpp"
+#include <cstdio>
+
+Plugin* pluginInstance;
+
+static int failures = 0;
+
+static void report(const char* name, bool ok) {
+	if (!ok) failures++;
+	printf("%-48s %s\n", name, ok ? "ok" : "FAILED");
+}
+
+// A patch loaded with a long maxSteps plays its first samples before the
+// worker has delivered storage that long; until then the steps played (and
+// filtered) must stay inside the storage the module started with.
+static void checkLoadedLongOrbit() {
+	ORBsqVi* m = new ORBsqVi;
+	json_t* rootJ = json_object();
+	json_object_set_new(rootJ, "maxSteps", json_integer(256));
+	json_object_set_new(rootJ, "steps", json_integer(200));
+	m->dataFromJson(rootJ);
+	m->params[ORBsqVi::FILTERTYPE_PARAM].setValue(1.f);
+	m->params[ORBsqVi::FILTER_PARAM].setValue(0.5f);
+	m->inputs[ORBsqVi::POS_INPUT].setChannels(16);
+	for (int c=0;c<16;c++) {
+		m->inputs[ORBsqVi::POS_INPUT].setVoltage(1.f + c * 0.5f, c);
+	}
+	Module::ProcessArgs args{44100.f, 1.f / 44100.f, 0};
+	// before anything reaches the worker, then while it is at work
+	m->processControls();
+	bool ok = m->steps <= m->curSeqVal->capacity;
+	for (int i=0;i<4410 && ok;i++) {
+		m->process(args);
+		ok = m->steps <= m->curSeqVal->capacity;
+	}
+	report("steps: loaded 256-step patch stays in storage", ok);
+	delete m;
+}
+
+int main() {
+	checkLoadedLongOrbit();
+
+	if (failures) {
+		printf("%d check(s) failed\n", failures);
+		return 1;
+	}
+	printf("all checks passed\n");
+	return 0;
+}
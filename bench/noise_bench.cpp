@@ -0,0 +1,242 @@
+// Throughput benchmark for OpenSimplexNoise. Times every Evaluate variant
+// (double, float, float batched) in 2D/3D/4D over three coordinate streams:
+// uniformly random points, ORBsqVi-style 16-step orbits on one z slice, and
+// a row-major 1/16 grid. Prints a table, and with --json writes the same
+// numbers as JSON so two builds can be diffed. Run with `make bench-noise`.
+//
+//   noise_bench [--points N] [--min-time S] [--json FILE|-]
+#include "OpenSimplexNoise.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+#if defined(__AVX__)
+static const int BATCH_LANES = 8;
+#elif defined(__SSE2__)
+static const int BATCH_LANES = 4;
+#else
+static const int BATCH_LANES = 1;
+#endif
+
+static const float ORBIT_Z = 10.f;
+
+// keeps the compiler from dropping passes whose result is otherwise unused
+static volatile double sink;
+
+struct Stream {
+	std::string name;
+	std::vector<float> x, y, z, w;
+};
+
+struct Result {
+	int dims;
+	std::string variant;
+	std::string stream;
+	double nsPerEval;
+	double cyclesPerEval;
+	double checksum;
+};
+
+static Stream randomStream(int n, std::mt19937& rng) {
+	std::uniform_real_distribution<float> coord(-19.5f, 30.5f);
+	Stream s;
+	s.name = "random";
+	for (int i=0;i<n;i++) {
+		s.x.push_back(coord(rng));
+		s.y.push_back(coord(rng));
+		s.z.push_back(coord(rng));
+		s.w.push_back(coord(rng));
+	}
+	return s;
+}
+
+// the points ORBsqVi evaluates: 16 steps around a Base/Range pair
+static Stream orbitStream(int n, std::mt19937& rng) {
+	std::uniform_real_distribution<float> base(1.f, 10.f);
+	std::uniform_real_distribution<float> range(1.f, 10.f);
+	Stream s;
+	s.name = "orbit";
+	while ((int)s.x.size() < n) {
+		float b = base(rng);
+		float r = std::pow(2.f, range(rng)) / 50.f;
+		for (int step=0;step<16 && (int)s.x.size() < n;step++) {
+			float ang = step * (2.f * (float)M_PI / 16.f);
+			s.x.push_back(b + std::sin(ang) * r);
+			s.y.push_back(b + std::cos(ang) * r);
+			s.z.push_back(ORBIT_Z);
+			s.w.push_back(0.f);
+		}
+	}
+	return s;
+}
+
+static Stream gridStream(int n) {
+	int side = (int)std::ceil(std::sqrt((double)n));
+	Stream s;
+	s.name = "grid";
+	for (int i=0;i<n;i++) {
+		s.x.push_back(-19.5f + (i % side) / 16.f);
+		s.y.push_back(-19.5f + (i / side) / 16.f);
+		s.z.push_back(ORBIT_Z);
+		s.w.push_back(0.f);
+	}
+	return s;
+}
+
+static uint64_t cycles() {
+#ifdef HAVE_TSC
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+// Runs pass() over the whole stream until minTime has elapsed, five times,
+// and keeps the fastest run.
+template <class Pass>
+static Result measure(int dims, const char* variant, const Stream& s, double minTime, Pass pass) {
+	Result r;
+	r.dims = dims;
+	r.variant = variant;
+	r.stream = s.name;
+	r.nsPerEval = 1e30;
+	r.cyclesPerEval = 0.0;
+	r.checksum = pass();
+	for (int run=0;run<5;run++) {
+		long evals = 0;
+		double elapsed = 0.0;
+		uint64_t c0 = cycles();
+		auto t0 = std::chrono::steady_clock::now();
+		while (elapsed < minTime) {
+			sink = pass();
+			evals += s.x.size();
+			elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+		}
+		uint64_t c1 = cycles();
+		double ns = elapsed * 1e9 / evals;
+		if (ns < r.nsPerEval) {
+			r.nsPerEval = ns;
+			r.cyclesPerEval = (double)(c1 - c0) / evals;
+		}
+	}
+	return r;
+}
+
+template <typename Real>
+static double scalarPass(OpenSimplexNoiseT<Real>& noise, int dims, const Stream& s) {
+	double sum = 0.0;
+	size_t n = s.x.size();
+	if (dims == 2) {
+		for (size_t i=0;i<n;i++) sum += noise.Evaluate(s.x[i], s.y[i]);
+	} else if (dims == 3) {
+		for (size_t i=0;i<n;i++) sum += noise.Evaluate(s.x[i], s.y[i], s.z[i]);
+	} else {
+		for (size_t i=0;i<n;i++) sum += noise.Evaluate(s.x[i], s.y[i], s.z[i], s.w[i]);
+	}
+	return sum;
+}
+
+// EvaluateBatch shares one z per call, so the random stream is fed in
+// 16-point groups that take the z of their first point
+static double batchPass(OpenSimplexNoiseF& noise, const Stream& s, std::vector<float>& out) {
+	double sum = 0.0;
+	int n = (int)s.x.size();
+	for (int i=0;i<n;i+=16) {
+		int count = std::min(16, n - i);
+		noise.EvaluateBatch(&s.x[i], &s.y[i], s.z[i], &out[i], count);
+	}
+	for (int i=0;i<n;i++) sum += out[i];
+	return sum;
+}
+
+static void writeJson(FILE* f, const std::vector<Result>& results, int points) {
+	fprintf(f, "{\n");
+	fprintf(f, "  \"benchmark\": \"OpenSimplexNoise\",\n");
+#ifdef __VERSION__
+	fprintf(f, "  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+	fprintf(f, "  \"batch_lanes\": %d,\n", BATCH_LANES);
+	fprintf(f, "  \"points\": %d,\n", points);
+	fprintf(f, "  \"results\": [\n");
+	for (size_t i=0;i<results.size();i++) {
+		const Result& r = results[i];
+		fprintf(f, "    {\"dims\": %d, \"variant\": \"%s\", \"stream\": \"%s\", \"evals_per_sec\": %.0f, \"ns_per_eval\": %.3f, ",
+			r.dims, r.variant.c_str(), r.stream.c_str(), 1e9 / r.nsPerEval, r.nsPerEval);
+#ifdef HAVE_TSC
+		fprintf(f, "\"cycles_per_eval\": %.1f, ", r.cyclesPerEval);
+#else
+		fprintf(f, "\"cycles_per_eval\": null, ");
+#endif
+		fprintf(f, "\"checksum\": %.9g}%s\n", r.checksum, i + 1 < results.size() ? "," : "");
+	}
+	fprintf(f, "  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+	int points = 1 << 14;
+	double minTime = 0.1;
+	const char* jsonPath = NULL;
+	for (int i=1;i<argc;i++) {
+		if (!strcmp(argv[i], "--points") && i + 1 < argc) {
+			points = std::max(16, atoi(argv[++i]));
+		} else if (!strcmp(argv[i], "--min-time") && i + 1 < argc) {
+			minTime = std::max(0.001, atof(argv[++i]));
+		} else if (!strcmp(argv[i], "--json") && i + 1 < argc) {
+			jsonPath = argv[++i];
+		} else {
+			fprintf(stderr, "usage: %s [--points N] [--min-time S] [--json FILE|-]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	std::mt19937 rng(3518);
+	std::vector<Stream> streams;
+	streams.push_back(randomStream(points, rng));
+	streams.push_back(orbitStream(points, rng));
+	streams.push_back(gridStream(points));
+
+	OpenSimplexNoise noiseD(3518);
+	OpenSimplexNoiseF noiseF(3518);
+	std::vector<float> out(points);
+	std::vector<Result> results;
+
+	for (int dims=2;dims<=4;dims++) {
+		for (const Stream& s : streams) {
+			results.push_back(measure(dims, "double", s, minTime, [&] { return scalarPass(noiseD, dims, s); }));
+			results.push_back(measure(dims, "float", s, minTime, [&] { return scalarPass(noiseF, dims, s); }));
+			if (dims == 3) {
+				results.push_back(measure(dims, "float-batch", s, minTime, [&] { return batchPass(noiseF, s, out); }));
+			}
+		}
+	}
+
+	// the table goes to stderr when the JSON goes to stdout
+	FILE* table = (jsonPath && !strcmp(jsonPath, "-")) ? stderr : stdout;
+	fprintf(table, "%d points per stream, batch lanes: %d\n", points, BATCH_LANES);
+	fprintf(table, "%-4s %-12s %-7s %12s %9s %9s\n", "dims", "variant", "stream", "evals/s", "ns/eval", "cyc/eval");
+	for (const Result& r : results) {
+		fprintf(table, "%-4d %-12s %-7s %12.0f %9.2f %9.1f\n", r.dims, r.variant.c_str(), r.stream.c_str(), 1e9 / r.nsPerEval, r.nsPerEval, r.cyclesPerEval);
+	}
+
+	if (jsonPath) {
+		FILE* f = strcmp(jsonPath, "-") ? fopen(jsonPath, "w") : stdout;
+		if (!f) {
+			fprintf(stderr, "cannot write %s\n", jsonPath);
+			return 1;
+		}
+		writeJson(f, results, points);
+		if (f != stdout) fclose(f);
+	}
+	return 0;
+}
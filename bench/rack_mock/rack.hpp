@@ -0,0 +1,401 @@
+// Minimal stand-in for the parts of the Rack 2 SDK that ORBsqVi uses, so the
+// module can be built and driven headless by the tools in bench/. Engine and
+// dsp types behave like Rack's; widgets, menus and NanoVG calls are no-ops.
+// Not used by the plugin build.
+#pragma once
+#include <cmath>
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <map>
+#include <cstdint>
+#include <algorithm>
+#include <pmmintrin.h>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <dirent.h>
+
+struct json_t { int type; bool b; double r; long long i; std::map<std::string, json_t*> o; std::vector<json_t*> a; std::string s; };
+inline json_t* json_object() { json_t* j = new json_t(); j->type = 0; return j; }
+inline json_t* json_array() { json_t* j = new json_t(); j->type = 5; return j; }
+inline int json_array_append_new(json_t* a, json_t* v) { a->a.push_back(v); return 0; }
+inline size_t json_array_size(json_t* a) { return a->a.size(); }
+inline json_t* json_array_get(json_t* a, size_t i) { return i < a->a.size() ? a->a[i] : nullptr; }
+inline json_t* json_boolean(bool b) { json_t* j = new json_t(); j->type = 1; j->b = b; return j; }
+inline json_t* json_integer(long long i) { json_t* j = new json_t(); j->type = 2; j->i = i; return j; }
+inline json_t* json_real(double r) { json_t* j = new json_t(); j->type = 3; j->r = r; return j; }
+inline json_t* json_string(const char* s) { json_t* j = new json_t(); j->type = 4; j->s = s; return j; }
+inline int json_object_set_new(json_t* o, const char* k, json_t* v) { o->o[k] = v; return 0; }
+inline json_t* json_object_get(const json_t* o, const char* k) { auto it = o->o.find(k); return it == o->o.end() ? nullptr : it->second; }
+inline bool json_boolean_value(const json_t* j) { return j->b; }
+inline long long json_integer_value(const json_t* j) { return j->i; }
+inline double json_real_value(const json_t* j) { return j->r; }
+inline double json_number_value(const json_t* j) { return j->type == 2 ? j->i : j->r; }
+inline const char* json_string_value(const json_t* j) { return j->s.c_str(); }
+inline void json_decref(json_t*) {}
+
+struct NVGcontext {};
+struct NVGcolor { float r, g, b, a; };
+enum { NVG_ROUND, NVG_BUTT, NVG_ALIGN_LEFT = 1, NVG_ALIGN_RIGHT = 4, NVG_ALIGN_CENTER = 2, NVG_ALIGN_TOP = 8, NVG_ALIGN_BASELINE = 64 };
+inline void nvgScissor(NVGcontext*, float, float, float, float) {}
+inline void nvgResetScissor(NVGcontext*) {}
+inline void nvgBeginPath(NVGcontext*) {}
+inline void nvgMoveTo(NVGcontext*, float, float) {}
+inline void nvgLineTo(NVGcontext*, float, float) {}
+inline void nvgRect(NVGcontext*, float, float, float, float) {}
+inline void nvgFill(NVGcontext*) {}
+inline void nvgFillColor(NVGcontext*, NVGcolor) {}
+inline void nvgLineCap(NVGcontext*, int) {}
+inline void nvgMiterLimit(NVGcontext*, float) {}
+inline void nvgStrokeWidth(NVGcontext*, float) {}
+inline void nvgStrokeColor(NVGcontext*, NVGcolor) {}
+inline void nvgStroke(NVGcontext*) {}
+inline void nvgFontSize(NVGcontext*, float) {}
+inline void nvgFontFaceId(NVGcontext*, int) {}
+inline void nvgTextAlign(NVGcontext*, int) {}
+inline float nvgText(NVGcontext*, float, float, const char*, const char*) { return 0; }
+inline NVGcolor nvgRGB(unsigned char r, unsigned char g, unsigned char b) { return NVGcolor{r/255.f, g/255.f, b/255.f, 1}; }
+inline NVGcolor nvgRGBA(unsigned char r, unsigned char g, unsigned char b, unsigned char a) { return NVGcolor{r/255.f, g/255.f, b/255.f, a/255.f}; }
+
+namespace rack {
+namespace plugin { struct Model; struct Plugin; }
+namespace math {
+inline float clamp(float x, float a = 0.f, float b = 1.f) { return std::fmax(std::fmin(x, b), a); }
+inline int clamp(int x, int a, int b) { return std::max(std::min(x, b), a); }
+inline float rescale(float x, float xMin, float xMax, float yMin, float yMax) { return yMin + (x - xMin) / (xMax - xMin) * (yMax - yMin); }
+inline bool isNear(float a, float b, float eps = 1e-6f) { return std::fabs(a - b) <= eps; }
+inline int eucMod(int a, int b) { int m = a % b; if (m < 0) m += b; return m; }
+struct Vec { float x = 0, y = 0; Vec() {} Vec(float x, float y) : x(x), y(y) {} Vec plus(Vec b) const { return Vec(x + b.x, y + b.y); } Vec mult(float s) const { return Vec(x*s, y*s); } };
+struct Rect { Vec pos, size; Rect() {} Rect(Vec p, Vec s) : pos(p), size(s) {} };
+}
+using namespace math;
+#define VEC_ARGS(v) (v).x, (v).y
+#define RECT_ARGS(r) (r).pos.x, (r).pos.y, (r).size.x, (r).size.y
+#define ENUMS(name, count) name, name##_LAST = name + (count) - 1
+#define GLFW_RELEASE 0
+#define GLFW_PRESS 1
+#define GLFW_MOUSE_BUTTON_LEFT 0
+inline float mm2px(float mm) { return mm * 75.f / 25.4f; }
+inline math::Vec mm2px(math::Vec mm) { return mm.mult(75.f / 25.4f); }
+static const float RACK_GRID_WIDTH = 15.f;
+static const float RACK_GRID_HEIGHT = 380.f;
+
+namespace simd {
+struct float_4 {
+	__m128 v;
+	float_4() {}
+	float_4(__m128 v) : v(v) {}
+	float_4(float x) : v(_mm_set1_ps(x)) {}
+	float_4(float a, float b, float c, float d) : v(_mm_setr_ps(a, b, c, d)) {}
+	static float_4 load(const float* p) { return _mm_loadu_ps(p); }
+	static float_4 zero() { return _mm_setzero_ps(); }
+	static float_4 mask() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+	void store(float* p) const { _mm_storeu_ps(p, v); }
+	float& operator[](int i) { return ((float*)&v)[i]; }
+	const float& operator[](int i) const { return ((const float*)&v)[i]; }
+};
+inline float_4 operator+(float_4 a, float_4 b) { return _mm_add_ps(a.v, b.v); }
+inline float_4 operator-(float_4 a, float_4 b) { return _mm_sub_ps(a.v, b.v); }
+inline float_4 operator*(float_4 a, float_4 b) { return _mm_mul_ps(a.v, b.v); }
+inline float_4 operator/(float_4 a, float_4 b) { return _mm_div_ps(a.v, b.v); }
+inline float_4 operator-(float_4 a) { return _mm_sub_ps(_mm_setzero_ps(), a.v); }
+inline float_4& operator+=(float_4& a, float_4 b) { a = a + b; return a; }
+inline float_4& operator-=(float_4& a, float_4 b) { a = a - b; return a; }
+inline float_4& operator*=(float_4& a, float_4 b) { a = a * b; return a; }
+inline float_4 operator>(float_4 a, float_4 b) { return _mm_cmpgt_ps(a.v, b.v); }
+inline float_4 operator<(float_4 a, float_4 b) { return _mm_cmplt_ps(a.v, b.v); }
+inline float_4 operator>=(float_4 a, float_4 b) { return _mm_cmpge_ps(a.v, b.v); }
+inline float_4 operator<=(float_4 a, float_4 b) { return _mm_cmple_ps(a.v, b.v); }
+inline float_4 operator==(float_4 a, float_4 b) { return _mm_cmpeq_ps(a.v, b.v); }
+inline float_4 operator!=(float_4 a, float_4 b) { return _mm_cmpneq_ps(a.v, b.v); }
+inline float_4 operator&(float_4 a, float_4 b) { return _mm_and_ps(a.v, b.v); }
+inline float_4 operator|(float_4 a, float_4 b) { return _mm_or_ps(a.v, b.v); }
+inline float_4 operator^(float_4 a, float_4 b) { return _mm_xor_ps(a.v, b.v); }
+inline float_4 operator~(float_4 a) { return _mm_xor_ps(a.v, float_4::mask().v); }
+inline float_4 fmin(float_4 a, float_4 b) { return _mm_min_ps(a.v, b.v); }
+inline float_4 fmax(float_4 a, float_4 b) { return _mm_max_ps(a.v, b.v); }
+inline float_4 clamp(float_4 x, float_4 a, float_4 b) { return fmin(fmax(x, a), b); }
+inline float_4 fabs(float_4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a.v); }
+inline float_4 ifelse(float_4 m, float_4 a, float_4 b) { return _mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v)); }
+inline int movemask(float_4 a) { return _mm_movemask_ps(a.v); }
+template <typename T> T movemaskInverse(int a);
+template <> inline float_4 movemaskInverse<float_4>(int a) { __m128i m = _mm_set1_epi32(a); m = _mm_and_si128(m, _mm_setr_epi32(1, 2, 4, 8)); m = _mm_cmpeq_epi32(m, _mm_setr_epi32(1, 2, 4, 8)); return _mm_castsi128_ps(m); }
+inline float_4 rescale(float_4 x, float_4 xMin, float_4 xMax, float_4 yMin, float_4 yMax) { return yMin + (x - xMin) / (xMax - xMin) * (yMax - yMin); }
+inline float_4 sin(float_4 a) { float_4 r; for (int i = 0; i < 4; i++) r[i] = std::sin(a[i]); return r; }
+inline float_4 pow(float_4 a, float_4 b) { float_4 r; for (int i = 0; i < 4; i++) r[i] = std::pow(a[i], b[i]); return r; }
+inline float_4 pow(float a, float_4 b) { float_4 r; for (int i = 0; i < 4; i++) r[i] = std::pow(a, b[i]); return r; }
+inline float_4 floor(float_4 a) { float_4 r; for (int i = 0; i < 4; i++) r[i] = std::floor(a[i]); return r; }
+inline float_4 round(float_4 a) { float_4 r; for (int i = 0; i < 4; i++) r[i] = std::round(a[i]); return r; }
+}
+
+namespace dsp {
+template <typename T = float>
+struct TSchmittTrigger {
+	T state;
+	TSchmittTrigger() { reset(); }
+	void reset() { state = T::mask(); }
+	T process(T in, T offThreshold = 0.f, T onThreshold = 1.f) {
+		T on = (in >= onThreshold);
+		T off = (in <= offThreshold);
+		T triggered = ~state & on;
+		state = on | (state & ~off);
+		return triggered;
+	}
+	T isHigh() { return state; }
+};
+template <>
+struct TSchmittTrigger<float> {
+	bool state = true;
+	void reset() { state = true; }
+	bool process(float in, float offThreshold = 0.f, float onThreshold = 1.f) {
+		if (state) { if (in <= offThreshold) state = false; }
+		else if (in >= onThreshold) { state = true; return true; }
+		return false;
+	}
+	bool isHigh() { return state; }
+};
+typedef TSchmittTrigger<float> SchmittTrigger;
+struct BooleanTrigger {
+	bool state = true;
+	bool process(bool s) { bool t = s && !state; state = s; return t; }
+};
+template <typename T = float>
+struct TPulseGenerator {
+	T remaining = 0.f;
+	void reset() { remaining = 0.f; }
+	T process(float deltaTime) { T mask = (remaining > 0.f); remaining -= ifelse(mask, T(deltaTime), T(0.f)); return mask; }
+	void trigger(T mask, float duration = 1e-3f) { remaining = ifelse(mask & (duration > remaining), T(duration), remaining); }
+};
+template <>
+struct TPulseGenerator<float> {
+	float remaining = 0.f;
+	void reset() { remaining = 0.f; }
+	bool process(float deltaTime) { if (remaining > 0.f) { remaining -= deltaTime; return true; } return false; }
+	void trigger(float duration = 1e-3f) { if (duration > remaining) remaining = duration; }
+};
+typedef TPulseGenerator<float> PulseGenerator;
+struct ClockDivider {
+	uint32_t clock = 0, division = 1;
+	void reset() { clock = 0; }
+	void setDivision(uint32_t d) { division = d; }
+	uint32_t getDivision() { return division; }
+	uint32_t getClock() { return clock; }
+	bool process() { clock++; if (clock >= division) { clock = 0; return true; } return false; }
+};
+}
+
+namespace string {
+inline std::string f(const char* fmt, ...) {
+	char buf[1024];
+	va_list args;
+	va_start(args, fmt);
+	vsnprintf(buf, sizeof(buf), fmt, args);
+	va_end(args);
+	return buf;
+}
+}
+namespace system {
+inline double getTime() { return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+inline std::string getFilename(const std::string& path) { size_t i = path.find_last_of('/'); return i == std::string::npos ? path : path.substr(i + 1); }
+inline std::vector<std::string> getEntries(const std::string& dir) { std::vector<std::string> entries; if (DIR* d = opendir(dir.c_str())) { while (dirent* e = readdir(d)) { std::string n = e->d_name; if (n != "." && n != "..") entries.push_back(dir + "/" + n); } closedir(d); } return entries; }
+inline bool remove(const std::string& path) { return std::remove(path.c_str()) == 0; }
+inline bool createDirectories(const std::string& path) { return std::system(("mkdir -p '" + path + "'").c_str()) == 0; }
+inline bool exists(const std::string& path) { FILE* f = std::fopen(path.c_str(), "rb"); if (f) std::fclose(f); return f != NULL; }
+}
+namespace logger {}
+#define DEBUG(...) do {} while (0)
+#define INFO(...) do {} while (0)
+#define WARN(...) do {} while (0)
+
+struct Quantity { virtual ~Quantity() {} };
+
+namespace engine {
+struct Param { float value = 0.f; float getValue() { return value; } void setValue(float v) { value = v; } };
+static const int PORT_MAX_CHANNELS = 16;
+struct Port {
+	float voltages[16] = {};
+	uint8_t channels = 0;
+	bool isConnected() { return channels > 0; }
+	float getVoltage(int c = 0) { return voltages[c]; }
+	float getPolyVoltage(int c) { return channels == 1 ? voltages[0] : voltages[c]; }
+	template <typename T> T getVoltageSimd(int c) { return T::load(&voltages[c]); }
+	template <typename T> T getPolyVoltageSimd(int c) { return channels == 1 ? T(voltages[0]) : getVoltageSimd<T>(c); }
+	void setVoltage(float v, int c = 0) { voltages[c] = v; }
+	template <typename T> void setVoltageSimd(T v, int c) { v.store(&voltages[c]); }
+	int getChannels() { return channels; }
+	void setChannels(int n) { channels = n; }
+	bool isMonophonic() { return channels == 1; }
+	bool isPolyphonic() { return channels > 1; }
+};
+struct Input : Port {};
+struct Output : Port {};
+struct Light { float value = 0.f; void setBrightness(float b) { value = b; } float getBrightness() { return value; } };
+struct ParamQuantity : Quantity { bool snapEnabled = false; float minValue = 0, maxValue = 1, defaultValue = 0; std::string name; Param* param = nullptr; float getValue() { return param ? param->value : 0; } void setValue(float v) { if (param) param->value = std::min(std::max(v, minValue), maxValue); } };
+struct SwitchQuantity : ParamQuantity {};
+struct PortInfo {};
+struct Message { void* producerMessage = nullptr; void* consumerMessage = nullptr; };
+struct Module {
+	int64_t id = 0;
+	std::vector<Param> params;
+	std::vector<Input> inputs;
+	std::vector<Output> outputs;
+	std::vector<Light> lights;
+	std::vector<ParamQuantity*> paramQuantities;
+	struct Expander {
+		int64_t moduleId = -1;
+		Module* module = nullptr;
+		void* producerMessage = nullptr;
+		void* consumerMessage = nullptr;
+		bool messageFlipRequested = false;
+		void requestMessageFlip() { messageFlipRequested = true; }
+	};
+	Expander leftExpander, rightExpander;
+	plugin::Model* model = nullptr;
+	virtual ~Module() {}
+	void config(int p, int i, int o, int l) { params.resize(p); inputs.resize(i); outputs.resize(o); lights.resize(l); paramQuantities.resize(p); for (auto& q : paramQuantities) q = new ParamQuantity(); }
+	template <class TParamQuantity = ParamQuantity>
+	TParamQuantity* configParam(int id, float mn, float mx, float def, std::string name = "", std::string unit = "", float = 0.f, float = 1.f, float = 0.f) { TParamQuantity* q = new TParamQuantity(); q->minValue = mn; q->maxValue = mx; q->defaultValue = def; q->name = name; q->param = &params[id]; paramQuantities[id] = q; params[id].value = def; return q; }
+	SwitchQuantity* configSwitch(int id, float mn, float mx, float def, std::string name = "", std::vector<std::string> = {}) { return configParam<SwitchQuantity>(id, mn, mx, def, name); }
+	SwitchQuantity* configButton(int id, std::string name = "") { return configParam<SwitchQuantity>(id, 0, 1, 0, name); }
+	PortInfo* configInput(int, std::string = "") { return nullptr; }
+	PortInfo* configOutput(int, std::string = "") { return nullptr; }
+	void configBypass(int, int) {}
+	struct ProcessArgs { float sampleRate; float sampleTime; int64_t frame; };
+	struct SampleRateChangeEvent { float sampleRate; float sampleTime; };
+	struct ResetEvent {};
+	struct RandomizeEvent {};
+	struct AddEvent {};
+	struct RemoveEvent {};
+	struct ExpanderChangeEvent { uint8_t side; };
+	virtual void process(const ProcessArgs&) {}
+	virtual void onSampleRateChange(const SampleRateChangeEvent&) {}
+	virtual void onReset(const ResetEvent&) { for (size_t i = 0; i < params.size(); i++) params[i].value = paramQuantities[i]->defaultValue; }
+	virtual void onAdd(const AddEvent&) {}
+	virtual void onRemove(const RemoveEvent&) {}
+	virtual void onExpanderChange(const ExpanderChangeEvent&) {}
+	virtual json_t* dataToJson() { return nullptr; }
+	virtual void dataFromJson(json_t*) {}
+};
+}
+using namespace engine;
+
+struct Font { int handle = 0; };
+struct Window { std::shared_ptr<Font> loadFont(const std::string&) { return std::make_shared<Font>(); } };
+struct Context { Window* window; struct Scene* scene; };
+inline Context* contextGet() { static Context c; return &c; }
+#define APP rack::contextGet()
+namespace asset { inline std::string system(std::string s) { return s; } inline std::string plugin(plugin::Plugin*, std::string s) { return s; } inline std::string user(std::string s) { return s; } }
+static const NVGcolor SCHEME_WHITE = {1, 1, 1, 1};
+
+namespace widget {
+struct Widget {
+	math::Rect box;
+	Widget* parent = nullptr;
+	std::vector<Widget*> children;
+	bool visible = true;
+	virtual ~Widget() {}
+	struct DrawArgs { NVGcontext* vg; math::Rect clipBox; void* fb; };
+	struct ButtonEvent { math::Vec pos; int button; int action; int mods; void consume(Widget*) const {} };
+	struct DragMoveEvent { math::Vec mouseDelta; int button; };
+	struct HoverScrollEvent { math::Vec scrollDelta; void consume(Widget*) const {} };
+	struct ContextCreateEvent { NVGcontext* vg; };
+	struct ContextDestroyEvent { NVGcontext* vg; };
+	struct DirtyEvent {};
+	virtual void draw(const DrawArgs&) {}
+	virtual void drawLayer(const DrawArgs&, int) {}
+	virtual void step() { for (Widget* c : children) c->step(); }
+	virtual void onButton(const ButtonEvent&) {}
+	virtual void onDragMove(const DragMoveEvent&) {}
+	virtual void onHoverScroll(const HoverScrollEvent&) {}
+	virtual void onContextCreate(const ContextCreateEvent& e) { for (Widget* c : children) c->onContextCreate(e); }
+	virtual void onContextDestroy(const ContextDestroyEvent& e) { for (Widget* c : children) c->onContextDestroy(e); }
+	virtual void onDirty(const DirtyEvent& e) { for (Widget* c : children) c->onDirty(e); }
+	void addChild(Widget* w) { w->parent = this; children.push_back(w); }
+	math::Vec getSize() { return box.size; }
+};
+// re-renders its children when drawn after setDirty(), a Dirty event or a
+// lost context, like Rack's; drawing it otherwise reuses the last render
+struct FramebufferWidget : Widget {
+	bool dirty = true;
+	bool hasFramebuffer = false;
+	int renders = 0;
+	void setDirty(bool d = true) { dirty = d; }
+	void onDirty(const DirtyEvent& e) override { setDirty(); Widget::onDirty(e); }
+	void onContextCreate(const ContextCreateEvent& e) override { setDirty(); Widget::onContextCreate(e); }
+	void onContextDestroy(const ContextDestroyEvent& e) override { hasFramebuffer = false; setDirty(); Widget::onContextDestroy(e); }
+	void draw(const DrawArgs& args) override {
+		if (!dirty && hasFramebuffer) return;
+		dirty = false;
+		hasFramebuffer = true;
+		renders++;
+		for (Widget* c : children) c->draw(args);
+	}
+};
+struct TransparentWidget : Widget {};
+struct OpaqueWidget : Widget {};
+}
+using namespace widget;
+namespace ui {
+struct MenuItem : widget::Widget { std::string text, rightText; bool disabled = false; virtual void onAction() {} virtual Widget* createChildMenu() { return nullptr; } };
+struct Menu : widget::Widget {};
+struct MenuSeparator : MenuItem {};
+struct Slider : widget::Widget { Quantity* quantity = nullptr; };
+struct MenuLabel : MenuItem {};
+}
+using namespace ui;
+inline MenuLabel* createMenuLabel(std::string) { return new MenuLabel; }
+inline MenuItem* createBoolPtrMenuItem(std::string, std::string, bool*) { return new MenuItem; }
+inline MenuItem* createMenuItem(std::string, std::string = "", std::function<void()> = nullptr, bool = false, bool = false) { return new MenuItem; }
+inline MenuItem* createBoolMenuItem(std::string, std::string, std::function<bool()>, std::function<void(bool)>, bool = false, bool = false) { return new MenuItem; }
+inline MenuItem* createIndexSubmenuItem(std::string, std::vector<std::string>, std::function<size_t()>, std::function<void(size_t)>, bool = false, bool = false) { return new MenuItem; }
+template <typename T> MenuItem* createIndexPtrSubmenuItem(std::string, std::vector<std::string>, T*) { return new MenuItem; }
+inline MenuItem* createSubmenuItem(std::string, std::string, std::function<void(Menu*)>, bool = false) { return new MenuItem; }
+
+namespace app {
+struct LedDisplay : widget::Widget {};
+struct SvgPanel : widget::Widget {};
+struct ParamWidget : widget::Widget {};
+struct PortWidget : widget::Widget {};
+struct ModuleLightWidget : widget::Widget {};
+struct ModuleWidget : widget::OpaqueWidget {
+	engine::Module* module = nullptr;
+	void setModule(engine::Module* m) { module = m; }
+	template <class T> T* getModule() { return dynamic_cast<T*>(module); }
+	void setPanel(widget::Widget*) { box.size = math::Vec(RACK_GRID_WIDTH * 20, RACK_GRID_HEIGHT); }
+	void addParam(ParamWidget* w) { addChild(w); }
+	void addInput(PortWidget* w) { addChild(w); }
+	void addOutput(PortWidget* w) { addChild(w); }
+	virtual void appendContextMenu(ui::Menu*) {}
+};
+}
+using namespace app;
+struct Davies1900hRedKnob : ParamWidget {};
+struct LEDSliderGreen : ParamWidget {};
+struct Trimpot : ParamWidget {};
+struct CKSS : ParamWidget {};
+struct CKSSThree : ParamWidget {};
+struct LEDButton : ParamWidget {};
+struct PJ301MPort : PortWidget {};
+struct ScrewSilver : widget::Widget {};
+struct GreenLight : ModuleLightWidget {};
+template <class T> struct MediumLight : T {};
+template <class T> struct SmallLight : T {};
+template <class TBase> struct GreenLightT : ModuleLightWidget {};
+inline widget::Widget* createPanel(std::string) { return new SvgPanel; }
+template <class T> T* createWidget(math::Vec pos) { T* w = new T; w->box.pos = pos; return w; }
+template <class T> T* createWidgetCentered(math::Vec pos) { T* w = new T; w->box.pos = pos; return w; }
+template <class T> T* createParamCentered(math::Vec, engine::Module*, int) { return new T; }
+template <class T> T* createInputCentered(math::Vec, engine::Module*, int) { return new T; }
+template <class T> T* createOutputCentered(math::Vec, engine::Module*, int) { return new T; }
+template <class T> T* createLightCentered(math::Vec, engine::Module*, int) { return new T; }
+
+namespace plugin {
+struct Model { std::string slug; };
+struct Plugin { std::string slug; void addModel(Model*) {} };
+}
+using namespace plugin;
+template <class TModule, class TModuleWidget> Model* createModel(std::string slug) { Model* m = new Model; m->slug = slug; return m; }
+}
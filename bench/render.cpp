@@ -0,0 +1,319 @@
+// Renders ORBsqVi sequences offline, far faster than real time, from the
+// module's own sources built against bench/rack_mock. The module is clocked
+// by a square wave and its Main, Filter and Drone CV and trigger outputs are
+// written to CSV (one row per change) or a 6-channel 32-bit float WAV.
+//
+//   render [OPTIONS] --out FILE.csv|FILE.wav
+//   render [OPTIONS] --jobs FILE [--threads N]
+//
+// A jobs file holds one parameter set per line, in the same option syntax
+// and including its own --out; options given on the command line are the
+// defaults every line starts from. Jobs render in parallel, one per thread.
+#include "../src/ORBsqVi.cpp"
+#include "../src/ORBsqViExpander.cpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+Plugin* pluginInstance;
+
+static const struct {
+	const char* name;
+	int param;
+} PARAM_OPTIONS[] = {
+	{"base", ORBsqVi::POSITION_PARAM},
+	{"range", ORBsqVi::VARIANCE_PARAM},
+	{"steps", ORBsqVi::STEPS_PARAM},
+	{"filter", ORBsqVi::FILTER_PARAM},
+	{"filter-type", ORBsqVi::FILTERTYPE_PARAM},
+	{"filter-offset", ORBsqVi::OFFSET1_PARAM},
+	{"drift", ORBsqVi::DRIFT_PARAM},
+	{"drift-speed", ORBsqVi::DRIFTSPEED_PARAM},
+	{"drift-type", ORBsqVi::DRIFTTYPE_PARAM},
+	{"amp", ORBsqVi::AMP_PARAM},
+	{"volt-scale", ORBsqVi::VOLTSCALE_PARAM},
+	{"seed", ORBsqVi::SEED_PARAM},
+	{"morph", ORBsqVi::MORPH_PARAM},
+	{"base-b", ORBsqVi::BASEB_PARAM},
+	{"range-b", ORBsqVi::RANGEB_PARAM},
+};
+
+static const int OUTPUTS[] = {
+	ORBsqVi::MAINCV_OUTPUT,
+	ORBsqVi::MAINTRIG_OUTPUT,
+	ORBsqVi::FILTERCV_OUTPUT,
+	ORBsqVi::FILTERTRIG_OUTPUT,
+	ORBsqVi::DRONECV_OUTPUT,
+	ORBsqVi::DRONETRIG_OUTPUT,
+};
+static const int NUM_OUTPUTS = sizeof(OUTPUTS) / sizeof(OUTPUTS[0]);
+
+struct Job {
+	// (param, value) in the order given; applied over the module defaults
+	std::vector<std::pair<int, float>> params;
+	bool invert = false;
+	// triggers per second; 8 is 16ths at 120 BPM
+	float clock = 8.f;
+	float seconds = 60.f;
+	float sampleRate = 44100.f;
+	std::string out;
+};
+
+static bool setParam(Job& job, const std::string& name, float value) {
+	for (const auto& o : PARAM_OPTIONS) {
+		if (name == o.name) {
+			job.params.push_back(std::make_pair(o.param, value));
+			return true;
+		}
+	}
+	return false;
+}
+
+// applies args to job; returns an error message, empty on success
+static std::string parseOptions(const std::vector<std::string>& args, Job& job, std::string* jobsFile, int* threads) {
+	for (size_t i=0;i<args.size();i++) {
+		const std::string& a = args[i];
+		if (a == "--invert") {
+			job.invert = true;
+			continue;
+		}
+		if (a.compare(0, 2, "--") || i + 1 >= args.size()) return "bad option " + a;
+		std::string name = a.substr(2);
+		const std::string& v = args[++i];
+		if (name == "out") {
+			job.out = v;
+			continue;
+		}
+		if (name == "jobs" && jobsFile) {
+			*jobsFile = v;
+			continue;
+		}
+		if (name == "threads" && threads) {
+			*threads = atoi(v.c_str());
+			continue;
+		}
+		char* end;
+		float f = strtof(v.c_str(), &end);
+		if (end == v.c_str() || *end) return "bad value " + v + " for " + a;
+		if (name == "clock") job.clock = f;
+		else if (name == "seconds") job.seconds = f;
+		else if (name == "sample-rate") job.sampleRate = f;
+		else if (!setParam(job, name, f)) return "unknown option " + a;
+	}
+	if (!(job.clock > 0.f) || !(job.seconds > 0.f) || !(job.sampleRate >= 1000.f)) return "clock, seconds and sample rate must be positive";
+	return "";
+}
+
+static bool endsWith(const std::string& s, const char* suffix) {
+	size_t n = strlen(suffix);
+	return s.size() >= n && !s.compare(s.size() - n, n, suffix);
+}
+
+// Writes frames as they come. WAV holds every frame; CSV only the frames
+// where an output changed, which for step-held CVs is a few rows per step.
+struct OutputWriter {
+	FILE* f = NULL;
+	bool wav = false;
+	float sampleRate = 0.f;
+	int64_t frames = 0;
+	float last[NUM_OUTPUTS];
+	std::vector<float> block;
+
+	bool open(const std::string& path, float rate) {
+		wav = endsWith(path, ".wav");
+		sampleRate = rate;
+		f = fopen(path.c_str(), "wb");
+		if (!f) return false;
+		if (wav) {
+			// sizes are patched in close()
+			writeWavHeader(0);
+		} else {
+			fprintf(f, "time,main_cv,main_trig,filter_cv,filter_trig,drone_cv,drone_trig\n");
+		}
+		return true;
+	}
+
+	void write(const float* v) {
+		if (wav) {
+			block.insert(block.end(), v, v + NUM_OUTPUTS);
+			if (block.size() >= 4096 * NUM_OUTPUTS) flush();
+		} else if (frames == 0 || memcmp(v, last, sizeof(last))) {
+			fprintf(f, "%.6f", frames / sampleRate);
+			for (int i=0;i<NUM_OUTPUTS;i++) fprintf(f, ",%.6g", v[i]);
+			fprintf(f, "\n");
+			memcpy(last, v, sizeof(last));
+		}
+		frames++;
+	}
+
+	bool close() {
+		bool ok = true;
+		if (wav) {
+			flush();
+			// RIFF sizes are 32 bits, about 67 minutes of 6 channels at 44.1 kHz
+			uint64_t dataBytes = (uint64_t)frames * NUM_OUTPUTS * sizeof(float);
+			ok = dataBytes <= 0xffffffffu - 36 && fseek(f, 0, SEEK_SET) == 0;
+			writeWavHeader((uint32_t)dataBytes);
+		}
+		ok = !ferror(f) && ok;
+		return fclose(f) == 0 && ok;
+	}
+
+private:
+	void flush() {
+		fwrite(block.data(), sizeof(float), block.size(), f);
+		block.clear();
+	}
+
+	template <typename T>
+	void put(T v) {
+		fwrite(&v, sizeof(v), 1, f);
+	}
+
+	// WAVE_FORMAT_IEEE_FLOAT, little-endian like the hosts this builds on
+	void writeWavHeader(uint32_t dataBytes) {
+		fwrite("RIFF", 1, 4, f);
+		put<uint32_t>(36 + dataBytes);
+		fwrite("WAVEfmt ", 1, 8, f);
+		put<uint32_t>(16);
+		put<uint16_t>(3);
+		put<uint16_t>(NUM_OUTPUTS);
+		put<uint32_t>((uint32_t)sampleRate);
+		put<uint32_t>((uint32_t)sampleRate * NUM_OUTPUTS * sizeof(float));
+		put<uint16_t>(NUM_OUTPUTS * sizeof(float));
+		put<uint16_t>(32);
+		fwrite("data", 1, 4, f);
+		put<uint32_t>(dataBytes);
+	}
+};
+
+static bool render(const Job& job, std::string& error) {
+	ORBsqVi* m = new ORBsqVi();
+	// no worker hand-off, so the render is the same on every run
+	m->synchronousSequences = true;
+	Module::SampleRateChangeEvent e;
+	e.sampleRate = job.sampleRate;
+	e.sampleTime = 1.f / job.sampleRate;
+	m->onSampleRateChange(e);
+	for (const auto& p : job.params) {
+		if (p.first == ORBsqVi::STEPS_PARAM || p.first == ORBsqVi::OFFSET1_PARAM) {
+			m->setMaxSteps(std::max(m->maxSteps, (int)p.second));
+		}
+	}
+	for (const auto& p : job.params) {
+		ParamQuantity* q = m->paramQuantities[p.first];
+		m->params[p.first].setValue(clamp(p.second, q->minValue, q->maxValue));
+	}
+	m->invertVoltage = job.invert;
+	m->inputs[ORBsqVi::TRIGGER_INPUT].setChannels(1);
+
+	OutputWriter w;
+	if (!w.open(job.out, job.sampleRate)) {
+		error = "cannot write " + job.out;
+		delete m;
+		return false;
+	}
+	Module::ProcessArgs args;
+	args.sampleRate = job.sampleRate;
+	args.sampleTime = 1.f / job.sampleRate;
+	int64_t frames = (int64_t)((double)job.seconds * job.sampleRate);
+	double phase = 0.0;
+	double phaseStep = (double)job.clock / job.sampleRate;
+	float v[NUM_OUTPUTS];
+	for (args.frame=0;args.frame<frames;args.frame++) {
+		m->inputs[ORBsqVi::TRIGGER_INPUT].setVoltage(phase < 0.5 ? 10.f : 0.f);
+		phase += phaseStep;
+		phase -= std::floor(phase);
+		m->process(args);
+		for (int i=0;i<NUM_OUTPUTS;i++) v[i] = m->outputs[OUTPUTS[i]].getVoltage(0);
+		w.write(v);
+	}
+	delete m;
+	if (!w.close()) {
+		error = "error writing " + job.out;
+		return false;
+	}
+	return true;
+}
+
+static int usage(const char* argv0, const std::string& error) {
+	if (!error.empty()) fprintf(stderr, "%s\n", error.c_str());
+	fprintf(stderr, "usage: %s [OPTIONS] --out FILE.csv|FILE.wav\n", argv0);
+	fprintf(stderr, "       %s [OPTIONS] --jobs FILE [--threads N]\n", argv0);
+	fprintf(stderr, "options (raw panel values):");
+	for (const auto& o : PARAM_OPTIONS) fprintf(stderr, " --%s V", o.name);
+	fprintf(stderr, " --invert\n  --clock HZ (8) --seconds S (60) --sample-rate HZ (44100)\n");
+	return 1;
+}
+
+int main(int argc, char** argv) {
+	Job defaults;
+	std::string jobsFile;
+	int threads = (int)std::thread::hardware_concurrency();
+	std::string error = parseOptions(std::vector<std::string>(argv + 1, argv + argc), defaults, &jobsFile, &threads);
+	if (!error.empty()) return usage(argv[0], error);
+
+	std::vector<Job> jobs;
+	if (jobsFile.empty()) {
+		jobs.push_back(defaults);
+	} else {
+		std::ifstream in(jobsFile);
+		if (!in) return usage(argv[0], "cannot read " + jobsFile);
+		std::string line;
+		int lineNo = 0;
+		while (std::getline(in, line)) {
+			lineNo++;
+			size_t hash = line.find('#');
+			if (hash != std::string::npos) line.erase(hash);
+			std::istringstream words(line);
+			std::vector<std::string> args;
+			std::string word;
+			while (words >> word) args.push_back(word);
+			if (args.empty()) continue;
+			Job job = defaults;
+			job.out.clear();
+			error = parseOptions(args, job, NULL, NULL);
+			if (!error.empty()) return usage(argv[0], jobsFile + ":" + std::to_string(lineNo) + ": " + error);
+			if (job.out.empty()) return usage(argv[0], jobsFile + ":" + std::to_string(lineNo) + ": no --out");
+			jobs.push_back(job);
+		}
+	}
+	for (const Job& job : jobs) {
+		if (job.out.empty()) return usage(argv[0], "no --out");
+	}
+
+	threads = clamp(threads, 1, (int)jobs.size());
+	std::atomic<size_t> next{0};
+	std::atomic<int> failed{0};
+	std::mutex printMutex;
+	auto wall0 = std::chrono::steady_clock::now();
+	auto worker = [&]() {
+		for (size_t i;(i = next++) < jobs.size();) {
+			auto t0 = std::chrono::steady_clock::now();
+			std::string jobError;
+			bool ok = render(jobs[i], jobError);
+			double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+			std::lock_guard<std::mutex> lock(printMutex);
+			if (ok) {
+				printf("%s: %.0f s rendered in %.2f s (%.0fx real time)\n", jobs[i].out.c_str(), jobs[i].seconds, s, jobs[i].seconds / std::max(s, 1e-6));
+			} else {
+				fprintf(stderr, "%s\n", jobError.c_str());
+				failed++;
+			}
+		}
+	};
+	std::vector<std::thread> pool;
+	for (int t=1;t<threads;t++) pool.push_back(std::thread(worker));
+	worker();
+	for (std::thread& t : pool) t.join();
+	if (jobs.size() > 1) {
+		printf("%zu jobs on %d threads in %.2f s\n", jobs.size(), threads, std::chrono::duration<double>(std::chrono::steady_clock::now() - wall0).count());
+	}
+	return failed ? 1 : 0;
+}
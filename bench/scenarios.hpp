@@ -0,0 +1,120 @@
+#pragma once
+// Scripted ORBsqVi workloads shared by the headless tools. Include after
+// ../src/ORBsqVi.cpp.
+#include <cmath>
+#include <cstring>
+
+static const float SAMPLE_RATE = 44100.f;
+// Rack's default engine block size
+static const int BLOCK_SIZE = 64;
+
+static float gate(int64_t frame, int period) {
+	return (frame % period) < period / 2 ? 10.f : 0.f;
+}
+
+static float lfo(int64_t frame, float hz) {
+	return std::sin(2.f * M_PI * hz * (frame / SAMPLE_RATE));
+}
+
+struct Scenario {
+	const char* name;
+	const char* description;
+	void (*setup)(ORBsqVi* m);
+	void (*drive)(ORBsqVi* m, int64_t frame);
+};
+
+static void setupDefault(ORBsqVi* m) {
+	m->params[ORBsqVi::POSITION_PARAM].setValue(3.3f);
+	m->params[ORBsqVi::VARIANCE_PARAM].setValue(6.f);
+	m->params[ORBsqVi::AMP_PARAM].setValue(2.f);
+	m->params[ORBsqVi::STEPS_PARAM].setValue(16);
+	m->params[ORBsqVi::DRIFT_PARAM].setValue(0.3f);
+	m->inputs[ORBsqVi::TRIGGER_INPUT].setChannels(1);
+}
+
+static void setupLfoRange(ORBsqVi* m) {
+	setupDefault(m);
+	m->inputs[ORBsqVi::VAR_INPUT].setChannels(1);
+}
+
+static void setupPoly(ORBsqVi* m) {
+	setupLfoRange(m);
+	m->inputs[ORBsqVi::POS_INPUT].setChannels(16);
+	for (int c=0;c<16;c++) {
+		m->inputs[ORBsqVi::POS_INPUT].setVoltage(1.f + c * 0.5f, c);
+	}
+}
+
+static void setupLong(ORBsqVi* m) {
+	setupLfoRange(m);
+	m->setMaxSteps(256);
+	m->params[ORBsqVi::STEPS_PARAM].setValue(256);
+}
+
+// every-sample controls, so a moving Filter CV rebuilds the filter each sample
+static void setupFilterAudio(ORBsqVi* m) {
+	setupDefault(m);
+	m->setControlRate(1);
+	m->params[ORBsqVi::FILTERTYPE_PARAM].setValue(1.f);
+	m->inputs[ORBsqVi::FILTER_INPUT].setChannels(1);
+}
+
+static void setupFilterPerTrigger(ORBsqVi* m) {
+	setupFilterAudio(m);
+	m->filterPerTrigger = true;
+}
+
+static void setupMorph(ORBsqVi* m) {
+	setupDefault(m);
+	m->params[ORBsqVi::BASEB_PARAM].setValue(7.1f);
+	m->params[ORBsqVi::RANGEB_PARAM].setValue(4.f);
+}
+
+// 16th notes at 120 BPM
+static void driveStatic(ORBsqVi* m, int64_t frame) {
+	m->inputs[ORBsqVi::TRIGGER_INPUT].setVoltage(gate(frame, 5512));
+}
+
+static void driveLfoRange(ORBsqVi* m, int64_t frame) {
+	driveStatic(m, frame);
+	m->inputs[ORBsqVi::VAR_INPUT].setVoltage(5.5f + 4.5f * lfo(frame, 0.5f));
+}
+
+static void driveFastTriggers(ORBsqVi* m, int64_t frame) {
+	m->inputs[ORBsqVi::TRIGGER_INPUT].setVoltage(gate(frame, 8));
+}
+
+static void driveStepsSweep(ORBsqVi* m, int64_t frame) {
+	driveStatic(m, frame);
+	int s = (int)(frame / (SAMPLE_RATE / 4.f)) % 15;
+	m->params[ORBsqVi::STEPS_PARAM].setValue(2 + s);
+}
+
+static void driveMorph(ORBsqVi* m, int64_t frame) {
+	driveStatic(m, frame);
+	m->params[ORBsqVi::MORPH_PARAM].setValue(0.5f + 0.5f * lfo(frame, 0.5f));
+}
+
+static void driveFilterAudio(ORBsqVi* m, int64_t frame) {
+	driveStatic(m, frame);
+	m->inputs[ORBsqVi::FILTER_INPUT].setVoltage(5.f + 5.f * lfo(frame, 220.f));
+}
+
+static const Scenario scenarios[] = {
+	{"static", "fixed params, 16ths at 120 BPM", setupDefault, driveStatic},
+	{"lfo-range", "0.5 Hz sine on Range CV", setupLfoRange, driveLfoRange},
+	{"fast-triggers", "trigger every 8 samples", setupDefault, driveFastTriggers},
+	{"steps-sweep", "Steps stepping 2..16 four times a second", setupDefault, driveStepsSweep},
+	{"poly16-lfo", "16 Base channels, 0.5 Hz sine on Range CV", setupPoly, driveLfoRange},
+	{"long256-lfo", "256 steps, 0.5 Hz sine on Range CV", setupLong, driveLfoRange},
+	{"filter-audio", "220 Hz sine on Filter CV (ALG), controls every sample", setupFilterAudio, driveFilterAudio},
+	{"filter-per-trig", "as filter-audio, Filter evaluated per trigger", setupFilterPerTrigger, driveFilterAudio},
+	{"morph-lfo", "0.5 Hz sine on Morph between two orbits", setupMorph, driveMorph},
+};
+
+static const Scenario* findScenario(const char* name) {
+	for (const Scenario& s : scenarios) {
+		if (!strcmp(name, s.name)) return &s;
+	}
+	return NULL;
+}
@@ -0,0 +1,421 @@
+// Records ORBsqVi workloads as compact binary traces and replays them
+// headlessly, so an optimization of the noise or filter path can be checked
+// against the engine that recorded the trace on exactly the same input and
+// timed on it. Both sides generate sequences inline (see
+// ORBsqVi::synchronousSequences), which makes a replay deterministic: any
+// output difference comes from the engine, not from thread timing.
+//
+//   trace record SCENARIO FILE [--seconds S]
+//   trace replay FILE [--tolerance V] [--repeat N]
+//
+// A trace holds the sample rate, the parameter values and menu settings the
+// scenario started from, then one event per change: a parameter, an input
+// voltage or channel count before a frame's process(), or an output voltage
+// or channel count after it. The outputs are the golden recording a replay
+// is compared against, exactly by default or within --tolerance volts.
+#include "../src/ORBsqVi.cpp"
+#include "../src/ORBsqViExpander.cpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "scenarios.hpp"
+
+Plugin* pluginInstance;
+
+static const char MAGIC[4] = {'O', 'R', 'B', 'T'};
+static const uint32_t VERSION = 1;
+
+enum EventKind {
+	PARAM,
+	INPUT_VOLTAGE,
+	INPUT_CHANNELS,
+	OUTPUT_VOLTAGE,
+	OUTPUT_CHANNELS
+};
+
+struct Event {
+	int64_t frame;
+	uint8_t kind;
+	uint8_t id;
+	uint8_t channel;
+	float value;
+};
+
+struct Trace {
+	float sampleRate = 0.f;
+	int64_t frames = 0;
+	std::vector<float> params;
+	std::string settings;
+	std::vector<Event> events;
+};
+
+// byte stream helpers; traces are read back on the machine that wrote them,
+// so values are stored in host order
+struct Writer {
+	std::string buf;
+
+	void bytes(const void* p, size_t n) {
+		buf.append((const char*)p, n);
+	}
+	template <typename T>
+	void put(T v) {
+		bytes(&v, sizeof(v));
+	}
+	void varint(uint64_t v) {
+		while (v >= 0x80) {
+			put<uint8_t>((uint8_t)(v | 0x80));
+			v >>= 7;
+		}
+		put<uint8_t>((uint8_t)v);
+	}
+	void str(const std::string& s) {
+		put<uint32_t>((uint32_t)s.size());
+		bytes(s.data(), s.size());
+	}
+};
+
+struct Reader {
+	const std::string& buf;
+	size_t pos = 0;
+	bool bad = false;
+
+	explicit Reader(const std::string& buf) : buf(buf) {}
+
+	bool done() const {
+		return pos >= buf.size();
+	}
+	void bytes(void* p, size_t n) {
+		if (pos + n > buf.size()) {
+			bad = true;
+			memset(p, 0, n);
+			pos = buf.size();
+			return;
+		}
+		memcpy(p, buf.data() + pos, n);
+		pos += n;
+	}
+	template <typename T>
+	T get() {
+		T v;
+		bytes(&v, sizeof(v));
+		return v;
+	}
+	uint64_t varint() {
+		uint64_t v = 0;
+		for (int shift=0;shift<64 && !bad;shift+=7) {
+			uint8_t b = get<uint8_t>();
+			v |= (uint64_t)(b & 0x7f) << shift;
+			if (!(b & 0x80)) break;
+		}
+		return v;
+	}
+	std::string str() {
+		uint32_t n = get<uint32_t>();
+		if (n > buf.size() - pos) {
+			bad = true;
+			return std::string();
+		}
+		std::string s = buf.substr(pos, n);
+		pos += n;
+		return s;
+	}
+};
+
+// The menu settings travel as the module's own dataToJson() tree
+static void writeJson(Writer& w, const json_t* j) {
+	w.put<uint8_t>((uint8_t)j->type);
+	switch (j->type) {
+		case 0:
+			w.put<uint32_t>((uint32_t)j->o.size());
+			for (const auto& kv : j->o) {
+				w.str(kv.first);
+				writeJson(w, kv.second);
+			}
+			break;
+		case 1: w.put<uint8_t>(j->b); break;
+		case 2: w.put<int64_t>(j->i); break;
+		case 3: w.put<double>(j->r); break;
+		case 4: w.str(j->s); break;
+		case 5:
+			w.put<uint32_t>((uint32_t)j->a.size());
+			for (const json_t* e : j->a) writeJson(w, e);
+			break;
+	}
+}
+
+static json_t* readJson(Reader& r) {
+	uint8_t type = r.get<uint8_t>();
+	switch (type) {
+		case 0: {
+			json_t* o = json_object();
+			uint32_t n = r.get<uint32_t>();
+			for (uint32_t i=0;i<n && !r.bad;i++) {
+				std::string key = r.str();
+				json_object_set_new(o, key.c_str(), readJson(r));
+			}
+			return o;
+		}
+		case 1: return json_boolean(r.get<uint8_t>() != 0);
+		case 2: return json_integer(r.get<int64_t>());
+		case 3: return json_real(r.get<double>());
+		case 4: return json_string(r.str().c_str());
+		case 5: {
+			json_t* a = json_array();
+			uint32_t n = r.get<uint32_t>();
+			for (uint32_t i=0;i<n && !r.bad;i++) json_array_append_new(a, readJson(r));
+			return a;
+		}
+	}
+	r.bad = true;
+	return json_object();
+}
+
+static bool saveTrace(const char* path, const Trace& t) {
+	Writer w;
+	w.bytes(MAGIC, sizeof(MAGIC));
+	w.put<uint32_t>(VERSION);
+	w.put<float>(t.sampleRate);
+	w.put<int64_t>(t.frames);
+	w.put<uint32_t>((uint32_t)t.params.size());
+	for (float v : t.params) w.put<float>(v);
+	w.str(t.settings);
+	int64_t frame = 0;
+	for (const Event& e : t.events) {
+		w.varint((uint64_t)(e.frame - frame));
+		frame = e.frame;
+		w.put<uint8_t>(e.kind);
+		w.put<uint8_t>(e.id);
+		w.put<uint8_t>(e.channel);
+		w.put<float>(e.value);
+	}
+	FILE* f = fopen(path, "wb");
+	if (!f) return false;
+	bool ok = fwrite(w.buf.data(), 1, w.buf.size(), f) == w.buf.size();
+	return fclose(f) == 0 && ok;
+}
+
+static bool loadTrace(const char* path, Trace& t) {
+	FILE* f = fopen(path, "rb");
+	if (!f) return false;
+	std::string buf;
+	char chunk[1 << 16];
+	size_t n;
+	while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) buf.append(chunk, n);
+	fclose(f);
+
+	Reader r(buf);
+	char magic[4];
+	r.bytes(magic, sizeof(magic));
+	if (memcmp(magic, MAGIC, sizeof(MAGIC)) || r.get<uint32_t>() != VERSION) return false;
+	t.sampleRate = r.get<float>();
+	t.frames = r.get<int64_t>();
+	uint32_t params = r.get<uint32_t>();
+	// params added since the recording stay at their defaults
+	if (params > ORBsqVi::PARAMS_LEN) return false;
+	t.params.resize(params);
+	for (float& v : t.params) v = r.get<float>();
+	t.settings = r.str();
+	int64_t frame = 0;
+	while (!r.done() && !r.bad) {
+		Event e;
+		frame += (int64_t)r.varint();
+		e.frame = frame;
+		e.kind = r.get<uint8_t>();
+		e.id = r.get<uint8_t>();
+		e.channel = r.get<uint8_t>();
+		e.value = r.get<float>();
+		t.events.push_back(e);
+	}
+	return !r.bad;
+}
+
+static ORBsqVi* createModule(float sampleRate) {
+	ORBsqVi* m = new ORBsqVi();
+	m->synchronousSequences = true;
+	Module::SampleRateChangeEvent e;
+	e.sampleRate = sampleRate;
+	e.sampleTime = 1.f / sampleRate;
+	m->onSampleRateChange(e);
+	return m;
+}
+
+// appends an event for every port value that differs from last, then
+// updates last
+template <typename P>
+static void diffPorts(std::vector<Event>& events, int64_t frame, P* ports, P* last, int count, uint8_t voltageKind, uint8_t channelsKind) {
+	for (int id=0;id<count;id++) {
+		if (ports[id].channels != last[id].channels) {
+			events.push_back({frame, channelsKind, (uint8_t)id, 0, (float)ports[id].channels});
+			last[id].channels = ports[id].channels;
+		}
+		for (int c=0;c<PORT_MAX_CHANNELS;c++) {
+			if (memcmp(&ports[id].voltages[c], &last[id].voltages[c], sizeof(float))) {
+				events.push_back({frame, voltageKind, (uint8_t)id, (uint8_t)c, ports[id].voltages[c]});
+				last[id].voltages[c] = ports[id].voltages[c];
+			}
+		}
+	}
+}
+
+static int record(const char* name, const char* path, float seconds) {
+	const Scenario* s = findScenario(name);
+	if (!s) {
+		fprintf(stderr, "unknown scenario %s\n", name);
+		return 1;
+	}
+	ORBsqVi* m = createModule(SAMPLE_RATE);
+	s->setup(m);
+
+	Trace t;
+	t.sampleRate = SAMPLE_RATE;
+	t.frames = (int64_t)(seconds * SAMPLE_RATE);
+	for (int i=0;i<ORBsqVi::PARAMS_LEN;i++) t.params.push_back(m->params[i].getValue());
+	Writer settings;
+	writeJson(settings, m->dataToJson());
+	t.settings = settings.buf;
+
+	// the module writes some params itself (Filter follows its CV), so only
+	// changes made by the scenario between frames are events
+	std::vector<float> lastParams = t.params;
+	std::vector<Input> lastInputs(ORBsqVi::INPUTS_LEN);
+	std::vector<Output> lastOutputs(ORBsqVi::OUTPUTS_LEN);
+	Module::ProcessArgs args;
+	args.sampleRate = SAMPLE_RATE;
+	args.sampleTime = 1.f / SAMPLE_RATE;
+	for (args.frame=0;args.frame<t.frames;args.frame++) {
+		s->drive(m, args.frame);
+		for (int i=0;i<ORBsqVi::PARAMS_LEN;i++) {
+			float v = m->params[i].getValue();
+			if (memcmp(&v, &lastParams[i], sizeof(float))) t.events.push_back({args.frame, PARAM, (uint8_t)i, 0, v});
+		}
+		diffPorts(t.events, args.frame, m->inputs.data(), lastInputs.data(), ORBsqVi::INPUTS_LEN, INPUT_VOLTAGE, INPUT_CHANNELS);
+		m->process(args);
+		diffPorts(t.events, args.frame, m->outputs.data(), lastOutputs.data(), ORBsqVi::OUTPUTS_LEN, OUTPUT_VOLTAGE, OUTPUT_CHANNELS);
+		for (int i=0;i<ORBsqVi::PARAMS_LEN;i++) lastParams[i] = m->params[i].getValue();
+	}
+	delete m;
+
+	if (!saveTrace(path, t)) {
+		fprintf(stderr, "cannot write %s\n", path);
+		return 1;
+	}
+	printf("%s: %lld frames, %zu events\n", path, (long long)t.frames, t.events.size());
+	return 0;
+}
+
+struct ReplayResult {
+	double ns = 0.0;
+	int64_t mismatchFrames = 0;
+	int64_t firstMismatch = -1;
+	float maxDiff = 0.f;
+};
+
+static ReplayResult replayOnce(const Trace& t, float tolerance) {
+	ORBsqVi* m = createModule(t.sampleRate);
+	Reader r(t.settings);
+	m->dataFromJson(readJson(r));
+	for (size_t i=0;i<t.params.size();i++) m->params[i].setValue(t.params[i]);
+
+	// outputs as the trace recorded them
+	std::vector<Output> golden(ORBsqVi::OUTPUTS_LEN);
+	ReplayResult res;
+	Module::ProcessArgs args;
+	args.sampleRate = t.sampleRate;
+	args.sampleTime = 1.f / t.sampleRate;
+	size_t next = 0;
+	auto t0 = std::chrono::steady_clock::now();
+	for (args.frame=0;args.frame<t.frames;args.frame++) {
+		for (;next < t.events.size() && t.events[next].frame == args.frame && t.events[next].kind < OUTPUT_VOLTAGE;next++) {
+			const Event& e = t.events[next];
+			if (e.kind == PARAM) m->params[e.id].setValue(e.value);
+			else if (e.kind == INPUT_VOLTAGE) m->inputs[e.id].setVoltage(e.value, e.channel);
+			else m->inputs[e.id].setChannels((int)e.value);
+		}
+		m->process(args);
+		for (;next < t.events.size() && t.events[next].frame == args.frame;next++) {
+			const Event& e = t.events[next];
+			if (e.kind == OUTPUT_VOLTAGE) golden[e.id].setVoltage(e.value, e.channel);
+			else golden[e.id].setChannels((int)e.value);
+		}
+
+		bool mismatch = false;
+		for (int id=0;id<ORBsqVi::OUTPUTS_LEN;id++) {
+			Output& out = m->outputs[id];
+			if (out.channels != golden[id].channels) mismatch = true;
+			for (int c=0;c<out.channels;c++) {
+				float d = std::abs(out.voltages[c] - golden[id].voltages[c]);
+				if (!(d <= tolerance)) mismatch = true;
+				if (d > res.maxDiff || d != d) res.maxDiff = d;
+			}
+		}
+		if (mismatch) {
+			if (res.firstMismatch < 0) res.firstMismatch = args.frame;
+			res.mismatchFrames++;
+		}
+	}
+	res.ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / std::max<int64_t>(1, t.frames);
+	delete m;
+	return res;
+}
+
+static int replay(const char* path, float tolerance, int repeat) {
+	Trace t;
+	if (!loadTrace(path, t)) {
+		fprintf(stderr, "cannot read trace %s\n", path);
+		return 1;
+	}
+	ReplayResult best;
+	for (int i=0;i<repeat;i++) {
+		ReplayResult res = replayOnce(t, tolerance);
+		if (i == 0 || res.ns < best.ns) best = res;
+	}
+	printf("%s: %lld frames, best of %d: %.1f ns per sample (sequence generation included)\n", path, (long long)t.frames, repeat, best.ns);
+	if (best.mismatchFrames > 0) {
+		printf("MISMATCH: %lld frames differ, first at frame %lld, max difference %g V (tolerance %g V)\n",
+			(long long)best.mismatchFrames, (long long)best.firstMismatch, best.maxDiff, tolerance);
+		return 2;
+	}
+	printf("outputs match the recording (max difference %g V, tolerance %g V)\n", best.maxDiff, tolerance);
+	return 0;
+}
+
+static int usage(const char* argv0) {
+	fprintf(stderr, "usage: %s record SCENARIO FILE [--seconds S]\n", argv0);
+	fprintf(stderr, "       %s replay FILE [--tolerance V] [--repeat N]\n", argv0);
+	fprintf(stderr, "scenarios:");
+	for (const Scenario& s : scenarios) fprintf(stderr, " %s", s.name);
+	fprintf(stderr, "\n");
+	return 1;
+}
+
+int main(int argc, char** argv) {
+	if (argc >= 4 && !strcmp(argv[1], "record")) {
+		float seconds = 10.f;
+		for (int i=4;i<argc;i++) {
+			if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+				seconds = std::max(0.1f, (float)atof(argv[++i]));
+			} else {
+				return usage(argv[0]);
+			}
+		}
+		return record(argv[2], argv[3], seconds);
+	}
+	if (argc >= 3 && !strcmp(argv[1], "replay")) {
+		float tolerance = 0.f;
+		int repeat = 1;
+		for (int i=3;i<argc;i++) {
+			if (!strcmp(argv[i], "--tolerance") && i + 1 < argc) {
+				tolerance = std::max(0.f, (float)atof(argv[++i]));
+			} else if (!strcmp(argv[i], "--repeat") && i + 1 < argc) {
+				repeat = std::max(1, atoi(argv[++i]));
+			} else {
+				return usage(argv[0]);
+			}
+		}
+		return replay(argv[2], tolerance, repeat);
+	}
+	return usage(argv[0]);
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cmath>
+
+// Sine source for the drift offsets, shared by ORBsqVi's trigger handling and
+// its display. Single values come from a 1024-point table with linear
+// interpolation; a whole row of per-step offsets is produced by rotating one
+// phasor, so a row costs two table lookups, one exact sin/cos pair for the
+// step angle and a complex multiply per step.
+//
+// Against std::sin, lookups are within 6e-6 over the 0-4*PI phases drift
+// uses and 16-step rows within 7e-6, i.e. under 35 uV at full Drift and Amp:
+// linear interpolation's (2*PI/TABLE_SIZE)^2/8 = 4.7e-6, plus float rounding.
+struct DriftOscillator {
+	static const int TABLE_SIZE = 1024;
+
+	static const DriftOscillator& get() {
+		static const DriftOscillator osc;
+		return osc;
+	}
+
+	float sin(float phase) const {
+		float x = phase * (float)(TABLE_SIZE / (2.0 * M_PI));
+		x -= std::floor(x * (1.f / TABLE_SIZE)) * TABLE_SIZE;
+		int i = (int)x;
+		float t = x - i;
+		// x can round up to exactly TABLE_SIZE
+		if (i >= TABLE_SIZE) i -= TABLE_SIZE;
+		return table[i] + (table[i + 1] - table[i]) * t;
+	}
+
+	float cos(float phase) const {
+		return sin(phase + (float)(M_PI / 2.0));
+	}
+
+	// out[i] = sin(phase + i * spacing) for i < count
+	void offsets(float phase, float spacing, int count, float* out) const {
+		float s = sin(phase);
+		float c = cos(phase);
+		// the step rotation's error would compound, so it is computed exactly
+		float rs = std::sin(spacing);
+		float rc = std::cos(spacing);
+		for (int i=0;i<count;i++) {
+			out[i] = s;
+			float ns = s * rc + c * rs;
+			c = c * rc - s * rs;
+			s = ns;
+		}
+	}
+
+private:
+	// one guard point so interpolation never wraps
+	float table[TABLE_SIZE + 1];
+
+	DriftOscillator() {
+		for (int i=0;i<=TABLE_SIZE;i++) {
+			table[i] = (float)std::sin(2.0 * M_PI * i / TABLE_SIZE);
+		}
+	}
+};
@@ -0,0 +1,160 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include "StepMask.hpp"
+
+// Euclidean rhythms as step masks, bit i set when step i is a pulse, so the
+// filter becomes a lookup and a rotate. Every pattern of up to TABLE_STEPS
+// steps is precomputed; longer ones are built on request in O(steps).
+//
+// SIMPLE is the original ORBsq Vi formula, pulse where
+// (pulses * i) % steps + pulses >= steps. BJORKLUND is Bjorklund's
+// algorithm as described by Toussaint, which starts on a pulse: E(3,8) is
+// x..x..x. where SIMPLE gives ..x..x.x; both spread the pulses as evenly as
+// possible, so they are rotations of each other.
+struct EuclideanPatterns {
+	static const int TABLE_STEPS = 16;
+	enum Algorithm {
+		SIMPLE,
+		BJORKLUND,
+		ALGORITHMS_LEN
+	};
+
+	// table[algorithm][steps][pulses]
+	uint16_t table[ALGORITHMS_LEN][TABLE_STEPS + 1][TABLE_STEPS + 1];
+
+	static const EuclideanPatterns& get() {
+		static const EuclideanPatterns patterns;
+		return patterns;
+	}
+
+	// any step count up to StepMask::MAX_STEPS
+	void pattern(int algorithm, int steps, int pulses, StepMask& out) const {
+		if (steps <= TABLE_STEPS) {
+			out.clear();
+			out.word[0] = table[algorithm][steps][pulses];
+		} else if (algorithm == BJORKLUND) {
+			bjorklund(steps, pulses, out);
+		} else {
+			simple(steps, pulses, out);
+		}
+	}
+
+	// whether step i of a pattern is a pulse: a table lookup up to
+	// TABLE_STEPS and SIMPLE's formula past it. A longer BJORKLUND pattern
+	// has no closed form and is built; EuclideanPulses keeps those.
+	bool pulse(int algorithm, int steps, int pulses, int i) const {
+		if (steps <= TABLE_STEPS) {
+			return (table[algorithm][steps][pulses] >> i) & 1;
+		}
+		if (algorithm == SIMPLE) {
+			return (pulses * i) % steps + pulses >= steps;
+		}
+		StepMask m;
+		bjorklund(steps, pulses, m);
+		return m.test(i);
+	}
+
+private:
+	EuclideanPatterns() {
+		for (int a=0;a<ALGORITHMS_LEN;a++) {
+			for (int s=0;s<=TABLE_STEPS;s++) {
+				for (int p=0;p<=TABLE_STEPS;p++) {
+					table[a][s][p] = 0;
+				}
+			}
+		}
+		StepMask m;
+		for (int steps=1;steps<=TABLE_STEPS;steps++) {
+			for (int pulses=0;pulses<=steps;pulses++) {
+				simple(steps, pulses, m);
+				table[SIMPLE][steps][pulses] = (uint16_t)m.word[0];
+				bjorklund(steps, pulses, m);
+				table[BJORKLUND][steps][pulses] = (uint16_t)m.word[0];
+			}
+		}
+	}
+
+	static void simple(int steps, int pulses, StepMask& out) {
+		out.clear();
+		for (int i=0;i<steps;i++) {
+			if ((pulses * i) % steps + pulses >= steps) out.set(i, true);
+		}
+	}
+
+	// a run of identical step groups, e.g. 3 x "x.."
+	struct Groups {
+		StepMask bits;
+		int length;
+		int count;
+
+		void append(const Groups& g) {
+			for (int i=0;i<g.length;i++) {
+				bits.set(length + i, g.bits.test(i));
+			}
+			length += g.length;
+		}
+	};
+
+	// Repeatedly pairs the leading groups with the trailing remainder groups
+	// until at most one remainder is left, then reads the groups out in order.
+	// The groups on each side are always identical, so a side is one group
+	// and a count, and nothing is allocated.
+	static void bjorklund(int steps, int pulses, StepMask& out) {
+		out.clear();
+		if (pulses <= 0) return;
+		Groups a, b;
+		a.bits.clear();
+		a.bits.set(0, true);
+		a.length = 1;
+		a.count = pulses;
+		b.bits.clear();
+		b.length = 1;
+		b.count = steps - pulses;
+		while (b.count > 1) {
+			int n = std::min(a.count, b.count);
+			Groups rest = a.count > n ? a : b;
+			rest.count -= n;
+			a.append(b);
+			a.count = n;
+			b = rest;
+		}
+		int i = 0;
+		for (const Groups* g : {&a, &b}) {
+			for (int k=0;k<g->count;k++) {
+				for (int j=0;j<g->length;j++) {
+					out.set(i++, g->bits.test(j));
+				}
+			}
+		}
+	}
+};
+
+// Single steps of patterns for a user that asks for one step at a time, with
+// pulse counts that keep changing. Long BJORKLUND patterns are built once per
+// step count and pulse count and kept, so every step after that is a lookup.
+struct EuclideanPulses {
+	bool pulse(int algorithm, int steps, int pulses, int i) {
+		const EuclideanPatterns& patterns = EuclideanPatterns::get();
+		if (steps <= EuclideanPatterns::TABLE_STEPS || algorithm != EuclideanPatterns::BJORKLUND) {
+			return patterns.pulse(algorithm, steps, pulses, i);
+		}
+		if (steps != builtSteps) {
+			for (int p=0;p<=StepMask::MAX_STEPS;p++) {
+				built[p] = false;
+			}
+			builtSteps = steps;
+		}
+		if (!built[pulses]) {
+			patterns.pattern(algorithm, steps, pulses, longPatterns[pulses]);
+			built[pulses] = true;
+		}
+		return longPatterns[pulses].test(i);
+	}
+
+private:
+	StepMask longPatterns[StepMask::MAX_STEPS + 1];
+	bool built[StepMask::MAX_STEPS + 1] = {};
+	int builtSteps = 0;
+};
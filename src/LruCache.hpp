@@ -0,0 +1,63 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+// Small fixed-capacity least-recently-used cache. Lookups scan linearly,
+// which beats hashing at the few dozen entries it is meant for, and nothing
+// is allocated except by setCapacity(). Not thread-safe: keep each cache on
+// one thread.
+template <typename Key, typename Value>
+struct LruCache {
+	struct Entry {
+		Key key;
+		Value value;
+		uint64_t lastUsed = 0;
+		bool used = false;
+	};
+	std::vector<Entry> entries;
+	uint64_t useClock = 0;
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+
+	// drops all entries; allocates, so call it off the audio thread
+	void setCapacity(size_t capacity) {
+		entries.assign(capacity, Entry());
+		useClock = 0;
+	}
+
+	size_t capacity() const {
+		return entries.size();
+	}
+
+	Value* find(const Key& key) {
+		for (size_t i=0;i<entries.size();i++) {
+			Entry& e = entries[i];
+			if (e.used && e.key == key) {
+				e.lastUsed = ++useClock;
+				hits++;
+				return &e.value;
+			}
+		}
+		misses++;
+		return nullptr;
+	}
+
+	// returns the slot to fill for key, evicting the least recently used
+	// entry; nullptr when the capacity is zero
+	Value* insert(const Key& key) {
+		if (entries.empty()) return nullptr;
+		Entry* victim = &entries[0];
+		for (size_t i=0;i<entries.size();i++) {
+			Entry& e = entries[i];
+			if (!e.used) {
+				victim = &e;
+				break;
+			}
+			if (e.lastUsed < victim->lastUsed) victim = &e;
+		}
+		victim->key = key;
+		victim->used = true;
+		victim->lastUsed = ++useClock;
+		return &victim->value;
+	}
+};
@@ -1,6 +1,22 @@
 #include "plugin.hpp"
 #include "OpenSimplexNoise.hpp"
+#include "TripleBuffer.hpp"
+#include "LruCache.hpp"
+#include "SharedNoise.hpp"
+#include "NoiseLattice.hpp"
+#include "OrbitAngles.hpp"
+#include "StepMask.hpp"
+#include "StepStorage.hpp"
+#include "DriftOscillator.hpp"
+#include "EuclideanPatterns.hpp"
+#include "SequenceAtlas.hpp"
+#include "ORBsqViBus.hpp"
 #include "ORBsqViDisplay.cpp"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+using simd::float_4;
 
 struct ORBsqVi : Module {
 
@@ -17,6 +33,10 @@ struct ORBsqVi : Module {
 		VOLTSCALE_PARAM,
 		FILTERTYPE_PARAM,
 		INVERT_PARAM,
+		SEED_PARAM,
+		MORPH_PARAM,
+		BASEB_PARAM,
+		RANGEB_PARAM,
 		PARAMS_LEN
 	};
 	enum InputId {
@@ -47,26 +67,56 @@ struct ORBsqVi : Module {
 		LIGHTS_LEN
     };
 
-	int curStep, steps, lastSteps, filter_steps, seed;
-	float base, variance, filter, filter2, drift;
+	// Every channel of TRIGGER/Base/Range CV gets its own orbit, step
+	// counter, filter state and drift phase. Per-sample state is kept as
+	// float_4 blocks of four channels; per-channel arrays are indexed by
+	// channel.
+	int channels = 1;
+	int lastChannels = 1;
+	int curStep[PORT_MAX_CHANNELS];
+	int steps, lastSteps, filter_steps, seed;
+	// Seed plus the expander's Seed CV, per channel; seed is channel 0's
+	int seeds[PORT_MAX_CHANNELS], lastSeeds[PORT_MAX_CHANNELS];
+	// longest orbit the Steps knob reaches; sequences are sized for it
+	int maxSteps = 16;
+	int lastMaxSteps = 16;
+	float base[PORT_MAX_CHANNELS], variance[PORT_MAX_CHANNELS];
+	float filter, filter2, drift;
 	float curScale1, curOffset1;
 	float curScale2, curOffset2;
-	float lastPos, lastVar, lastFilter;
-	float curSeqVal[16];
-	bool curSeqState[16];
-	float displayStepVal[16];
-	float curVolt, droneVolt;
-	float driftAmt, driftAcc, drift_div;
-	bool triggerMain, triggerFiltered, triggerDrone;
+	float lastPos[PORT_MAX_CHANNELS], lastVar[PORT_MAX_CHANNELS];
+	float lastFilter;
+	bool lastInvert;
+	bool lastApproximate = false;
+	// Morph crossfades each step from orbit A (Base/Range) to orbit B. The
+	// worker only adds B to a sequence while Morph is in use, and the blend
+	// itself is done here, so moving Morph never evaluates noise.
+	float morph[PORT_MAX_CHANNELS], lastMorph[PORT_MAX_CHANNELS];
+	float baseB, varianceB, lastBaseB, lastVarB;
+	bool morphWanted = false;
+	bool lastMorphWanted = false;
+	const StepStorage* curSeqVal;
+	// bit i set when step i passes the filter
+	StepMask curSeqMask[PORT_MAX_CHANNELS];
+	float_4 mainVolt[4], filteredVolt[4], droneVolt[4];
+	float_4 driftAcc[4];
+	float driftAmt, drift_div;
+	const DriftOscillator& driftOsc = DriftOscillator::get();
 	float TWO_PI = 2.f * M_PI;
-	int delayCount = 0;
-	float driftSpeed;
+	float driftSpeed = 1.f;
+	float voltScale = 0.f;
 	bool invertVoltage = false;
 	float filterType = 0.0f;
 	float oldFilterType = 0.0f;
 	float filterShift = 0.0f;
 	float oldFilterShift = 0.0f;
-	bool triggered = false;
+	int euclideanAlgorithm = EuclideanPatterns::SIMPLE;
+	int oldEuclideanAlgorithm = EuclideanPatterns::SIMPLE;
+	const EuclideanPatterns& euclideanPatterns = EuclideanPatterns::get();
+	// per-trigger mode's single steps
+	EuclideanPulses euclideanPulses;
+	bool filterPerTrigger = false;
+	bool lastFilterPerTrigger = false;
 	float baseDriftAcc = 0.00000125f;
 	float currentDriftAcc = baseDriftAcc;
 	bool canDriftNormal = true;
@@ -74,16 +124,160 @@ struct ORBsqVi : Module {
 	bool canDriftDrone = true;
 	bool resetResetsDrift = false;
 
-	dsp::SchmittTrigger inTrigger;
-	dsp::SchmittTrigger inReset;
-	dsp::PulseGenerator pulseOutputMain;  // main
-	dsp::PulseGenerator pulseOutputFiltered; // filtered
-	dsp::PulseGenerator pulseOutputDrone; // drone
+	dsp::TSchmittTrigger<float_4> inTrigger[4];
+	dsp::TSchmittTrigger<float_4> inReset[4];
+	dsp::TPulseGenerator<float_4> pulseOutputMain[4];  // main
+	dsp::TPulseGenerator<float_4> pulseOutputFiltered[4]; // filtered
+	dsp::TPulseGenerator<float_4> pulseOutputDrone[4]; // drone
 	dsp::BooleanTrigger invertTrigger;
-
-	OpenSimplexNoise simplexNoise;
-
-	float curSampleRate = 0.f;
+	dsp::ClockDivider controlDivider;
+	int controlRate = 16;
+	// Base/Range CV resolution: exact, then steps in the 1-10 CV range
+	int cvResolution = 1;
+	float cvResolutionSteps[4] = {0.f, 0.002f, 0.01f, 0.05f};
+	float posCV[PORT_MAX_CHANNELS];
+	float varCV[PORT_MAX_CHANNELS];
+
+	// Seed 0 is the noise field ORBsq Vi always used
+	static const int64_t NOISE_SEED_BASE = 3518;
+	static constexpr float ORBIT_Z = 10.f;
+	// the process-wide engines of recently used seeds, held by the worker so
+	// flipping between seeds does not rebuild permutation tables
+	LruCache<int, std::shared_ptr<SharedNoise>> noiseCache;
+
+	// Step regeneration runs on seqWorker. process() posts the orbit it wants
+	// into seqRequests and picks finished step values up from sequences; both
+	// hand-offs are lock-free, so the audio thread never evaluates noise.
+	// Waking the worker takes seqWorkerMutex, which the worker only holds
+	// while it checks for a request.
+	struct SequenceRequest {
+		// requestId when posted
+		uint32_t id = 0;
+		float base[PORT_MAX_CHANNELS] = {};
+		float variance[PORT_MAX_CHANNELS] = {};
+		int channels = 1;
+		int steps = 0;
+		// maxSteps when requested
+		int capacity = 16;
+		int seed[PORT_MAX_CHANNELS] = {};
+		bool invert = false;
+		bool approximate = false;
+		// B is only generated when morph is set
+		bool morph = false;
+		float baseB = 0.f;
+		float varianceB = 0.f;
+	};
+	struct StepSequence {
+		// orbit A
+		StepStorage val;
+		// orbit B; a single row that every channel blends towards
+		StepStorage valB;
+		// A blended towards B; written by the audio thread while it holds
+		// the sequence
+		StepStorage mixed;
+		SequenceRequest request;
+	};
+	// Orbits already evaluated on the worker, so flipping between known
+	// Base/Range scenes costs a lookup. An orbit is stored by OrbitAngles
+	// point rather than by step, so changing Steps only evaluates angles no
+	// earlier step count needed. Points missing here are looked for in the
+	// seed's SharedNoise before they are evaluated.
+	LruCache<OrbitKey, OrbitPoints> seqCache;
+	static const int ORBIT_BATCH = 64;
+	// worker-owned; only allocated while useNoiseLattice is on
+	NoiseLattice noiseLattice;
+	bool useNoiseLattice = false;
+	std::atomic<int> seqCacheCapacity{32};
+	std::atomic<uint64_t> seqCacheHits{0};
+	std::atomic<uint64_t> seqCacheMisses{0};
+	// points copied from other instances' orbits
+	std::atomic<uint64_t> seqSharedPoints{0};
+	TripleBuffer<SequenceRequest> seqRequests;
+	TripleBuffer<StepSequence> sequences;
+	// worker scratch
+	std::vector<int> missingPoints;
+	std::thread seqWorker;
+	std::mutex seqWorkerMutex;
+	std::condition_variable seqWorkerCv;
+	std::atomic<bool> seqWorkerStop{false};
+	bool sequenceChanged = false;
+	uint32_t requestId = 0;
+	// Triggers that arrive while a request is still on the worker wait for
+	// the sequence for heldFor (or a later one), so they play the orbit of a
+	// Base/Range/Steps change on the same sample, but for at most
+	// TRIGGER_HOLD samples; then they play the current sequence. Held
+	// triggers are counted per channel and released one per sample, so none
+	// is lost.
+	static const int TRIGGER_HOLD = 8;
+	int heldTriggers[PORT_MAX_CHANNELS] = {};
+	int heldTotal = 0;
+	uint32_t heldFor = 0;
+	int holdAge = 0;
+	// headless tools set this before the first process() to generate
+	// sequences inline instead of on seqWorker, so the output no longer
+	// depends on thread timing
+	bool synchronousSequences = false;
+	std::atomic<int> regenCount{0};
+	int regenPerSecond = 0;
+	float regenRateTime = 0.f;
+	bool showRegenRate = false;
+
+	// The display's map of the current seed. atlasThread loads it, or builds
+	// and saves it on all cores, and hands it to the UI thread through an
+	// atomic shared_ptr; the audio thread never touches it.
+	bool showAtlas = false;
+	std::shared_ptr<const SequenceAtlas> atlas;
+	std::thread atlasThread;
+	std::atomic<bool> atlasBusy{false};
+	std::atomic<bool> atlasCancel{false};
+	// a Seed that is being swept or automated is not loaded or built until
+	// it has rested for ATLAS_SETTLE_TIME; the first seed shown is at once
+	int atlasSeed = -1;
+	double atlasSeedTime = 0.0;
+	static constexpr double ATLAS_SETTLE_TIME = 1.0;
+	// saved atlases kept in the user folder, newest first
+	static const int ATLAS_FILES = 16;
+
+	// Everything ORBsqViDisplay draws. The audio thread publishes a fresh copy
+	// at about DISPLAY_RATE Hz and the UI thread only ever reads the latest
+	// one, so drawing never touches engine state. version counts publishes;
+	// 0 means nothing has been published yet.
+	struct DisplaySnapshot {
+		uint32_t version = 0;
+		float stepVal[StepMask::MAX_STEPS] = {};
+		StepMask stepMask = {};
+		int steps = 0;
+		int filterSteps = 0;
+		bool euclideanFilter = false;
+		int curStep = -1;
+		float driftPhase = 0.f;
+		float driftDiv = 0.f;
+		float drift = 0.f;
+		float scale = 0.f;
+		bool canDriftNormal = true;
+		bool canDriftFiltered = true;
+		bool canDriftDrone = true;
+		bool showRegenRate = false;
+		int regenPerSecond = 0;
+		// channel 0's orbit, Range as on the knob
+		int seed = 0;
+		float base = 0.f;
+		float range = 0.f;
+	};
+	// the expander's step table changes whenever busChanged is raised
+	uint32_t busVersion = 1;
+	bool busChanged = false;
+	float busScale = 0.f;
+	float busVoltScale = 0.f;
+	bool busCanDriftNormal = true;
+	bool busCanDriftFiltered = true;
+	// rightExpander's buffers, for what the expander sends back
+	ORBsqViControls controlMessages[2];
+
+	static constexpr float DISPLAY_RATE = 150.f;
+	TripleBuffer<DisplaySnapshot> displaySnapshots;
+	dsp::ClockDivider displayDivider;
+	uint32_t displayVersion = 0;
 
 	ORBsqVi() {
 		config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
@@ -101,6 +295,11 @@ struct ORBsqVi : Module {
 		configInput(AMP_INPUT, "Amp 0-10v CV");
 		configInput(FILTER_INPUT, "Filter 0-10v CV");
 		configParam(INVERT_PARAM, 0,1,1, "Invert Voltage Range");
+		configParam(SEED_PARAM, 0.f, 999.f, 0.f, "Seed");
+		paramQuantities[SEED_PARAM]->snapEnabled = true;
+		configParam(MORPH_PARAM, 0.f, 1.f, 0.f, "Morph A to B", "%", 0.f, 100.f);
+		configParam(BASEB_PARAM, 1.f, 10.f, 1.f, "Base Position B");
+		configParam(RANGEB_PARAM, 1.f, 10.f, 1.f, "Range B");
 		configOutput(MAINCV_OUTPUT, "Main Note CV");
 		configOutput(MAINTRIG_OUTPUT, "Main Note Trig");
 		configOutput(FILTERCV_OUTPUT, "Filtered Note CV");
@@ -115,34 +314,324 @@ struct ORBsqVi : Module {
 
 		paramQuantities[STEPS_PARAM]->snapEnabled = true;
 
-		simplexNoise = OpenSimplexNoise(3518);
+		// enough for a different seed on every channel
+		noiseCache.setCapacity(PORT_MAX_CHANNELS);
 
-		curStep = -1;
-		driftAcc = 0.0f;
 		drift = 40.f;
-		lastPos = -10.0f;
-		lastVar = -10.0f;
+		for (int c=0;c<PORT_MAX_CHANNELS;c++) {
+			curStep[c] = -1;
+			lastPos[c] = -10.0f;
+			lastVar[c] = -10.0f;
+			posCV[c] = -10.f;
+			varCV[c] = -10.f;
+			morph[c] = 0.f;
+			lastMorph[c] = 0.f;
+			seeds[c] = 0;
+			lastSeeds[c] = -1;
+		}
+		baseB = lastBaseB = 1.f;
+		varianceB = lastVarB = 2.f;
+		for (int b=0;b<4;b++) {
+			driftAcc[b] = 0.f;
+			mainVolt[b] = 0.f;
+			filteredVolt[b] = 0.f;
+			droneVolt[b] = 0.f;
+		}
 		lastFilter = -10.0f;
 		lastSteps = 30;
-		seed = 1;
+		lastInvert = false;
+		seed = 0;
+		steps = 8;
+		curScale1 = 0.f;
+		drift_div = 0.f;
+		controlDivider.setDivision(controlRate);
+		displayDivider.setDivision(44100 / DISPLAY_RATE);
+
+		for (int i=0;i<3;i++) {
+			sequences.slots[i].val.resize(PORT_MAX_CHANNELS, maxSteps);
+		}
+		curSeqVal = &sequences.front().val;
+		for (int c=0;c<PORT_MAX_CHANNELS;c++) {
+			curSeqMask[c].clear();
+		}
+
+		rightExpander.producerMessage = &controlMessages[0];
+		rightExpander.consumerMessage = &controlMessages[1];
+
+		seqWorker = std::thread(&ORBsqVi::seqWorkerLoop, this);
+	}
+
+	~ORBsqVi() {
+		seqWorkerStop = true;
+		wakeSeqWorker();
+		seqWorker.join();
+		atlasCancel = true;
+		if (atlasThread.joinable()) atlasThread.join();
+	}
+
+	static std::string atlasPath(int seed) {
+		return asset::user(pluginInstance->slug + "/ORBsqVi-atlas-" + std::to_string(seed) + ".bin");
+	}
+
+	// deletes all but the ATLAS_FILES most recently saved atlases
+	static void pruneAtlases() {
+		std::vector<std::string> saved;
+		for (const std::string& path : system::getEntries(asset::user(pluginInstance->slug))) {
+			std::string name = system::getFilename(path);
+			if (name.compare(0, 14, "ORBsqVi-atlas-") == 0 && name.size() > 18 && name.compare(name.size() - 4, 4, ".bin") == 0) {
+				saved.push_back(path);
+			}
+		}
+		for (const std::string& path : SequenceAtlas::oldest(saved, ATLAS_FILES)) {
+			system::remove(path);
+		}
+	}
+
+	// UI thread: starts loading or building seed's atlas once the seed has
+	// settled, unless it is the current one or already on its way
+	void requestAtlas(int seed) {
+		std::shared_ptr<const SequenceAtlas> current = std::atomic_load(&atlas);
+		if ((current && current->noiseSeed == NOISE_SEED_BASE + seed) || atlasBusy) return;
+		double now = system::getTime();
+		if (seed != atlasSeed) {
+			atlasSeedTime = atlasSeed < 0 ? now - ATLAS_SETTLE_TIME : now;
+			atlasSeed = seed;
+		}
+		// the atlas file is only looked at, by load(), once the seed settles
+		if (now - atlasSeedTime < ATLAS_SETTLE_TIME) return;
+		if (atlasThread.joinable()) atlasThread.join();
+		atlasBusy = true;
+		atlasThread = std::thread([this, seed]() {
+			std::shared_ptr<SequenceAtlas> a = std::make_shared<SequenceAtlas>();
+			std::string path = atlasPath(seed);
+			if (!a->load(path, NOISE_SEED_BASE + seed, ORBIT_Z)) {
+				std::shared_ptr<SharedNoise> noise = SharedNoise::acquire(NOISE_SEED_BASE + seed);
+				if (!a->build(noise->noise, NOISE_SEED_BASE + seed, ORBIT_Z, atlasCancel)) {
+					atlasBusy = false;
+					return;
+				}
+				// an unsaved atlas still shows; it is rebuilt next time
+				system::createDirectories(asset::user(pluginInstance->slug));
+				if (a->save(path)) pruneAtlases();
+			}
+			std::atomic_store(&atlas, std::shared_ptr<const SequenceAtlas>(a));
+			atlasBusy = false;
+		});
+	}
+
+	SharedNoise& noiseFor(int seed) {
+		std::shared_ptr<SharedNoise>* noise = noiseCache.find(seed);
+		if (!noise) {
+			noise = noiseCache.insert(seed);
+			*noise = SharedNoise::acquire(NOISE_SEED_BASE + seed);
+		}
+		return **noise;
+	}
+
+	// evaluates the listed OrbitAngles points of key's orbit, in batches of
+	// up to ORBIT_BATCH
+	void evaluateOrbit(const OrbitKey& key, const int* points, int count, OrbitPoints& orbit) {
+		while (count > ORBIT_BATCH) {
+			evaluateOrbitBatch(key, points, ORBIT_BATCH, orbit);
+			points += ORBIT_BATCH;
+			count -= ORBIT_BATCH;
+		}
+		evaluateOrbitBatch(key, points, count, orbit);
+		regenCount++;
+	}
+
+	void evaluateOrbitBatch(const OrbitKey& key, const int* points, int count, OrbitPoints& orbit) {
+		const OrbitAngles& angles = OrbitAngles::get();
+		float orbitX[ORBIT_BATCH], orbitY[ORBIT_BATCH], out[ORBIT_BATCH];
+		for (int i=0;i<count;i++) {
+			float ang = angles.angle[points[i]];
+			orbitX[i] = key.base + std::sin(ang) * (key.variance/50.f);
+			orbitY[i] = key.base + std::cos(ang) * (key.variance/50.f);
+		}
+		if (key.approximate) {
+			if (!noiseLattice.isBuiltFor(NOISE_SEED_BASE + key.seed, ORBIT_Z)) {
+				noiseLattice.build(noiseFor(key.seed).noise, NOISE_SEED_BASE + key.seed, ORBIT_Z);
+			}
+			for (int i=0;i<count;i++) {
+				out[i] = noiseLattice.sample(orbitX[i], orbitY[i]);
+			}
+		} else {
+			// all orbit points share the z slice, so evaluate them together
+			noiseFor(key.seed).noise.EvaluateBatch(orbitX, orbitY, ORBIT_Z, out, count);
+		}
+		for (int i=0;i<count;i++) {
+			orbit.val[points[i]] = clamp(out[i],-1.0f,1.0f);
+			orbit.mark(points[i]);
+		}
+	}
+
+	// lists the points of req's steps that orbit lacks in missingPoints
+	int countMissing(const SequenceRequest& req, const uint16_t* stepPoints, const OrbitPoints& orbit) {
+		int numMissing = 0;
+		for (int r=0;r<req.steps;r++) {
+			if (!orbit.has(stepPoints[r])) missingPoints[numMissing++] = stepPoints[r];
+		}
+		return numMissing;
+	}
+
+	// writes the steps of key's orbit to row, from the caches where it can
+	void orbitSteps(const SequenceRequest& req, const OrbitKey& key, float* row) {
+		const OrbitAngles& angles = OrbitAngles::get();
+		const uint16_t* stepPoints = angles.index(req.steps);
+		int points = angles.points(req.capacity);
+
+		OrbitPoints scratch;
+		OrbitPoints* orbit = seqCache.find(key);
+		if (!orbit) {
+			orbit = seqCache.insert(key);
+			if (!orbit) orbit = &scratch;
+			orbit->reserve(points);
+			orbit->clear();
+		}
+		orbit->reserve(points);
+
+		int numMissing = countMissing(req, stepPoints, *orbit);
+		if (numMissing > 0) {
+			SharedNoise& shared = noiseFor(key.seed);
+			int fetched = shared.fetch(key, *orbit);
+			if (fetched > 0) {
+				seqSharedPoints += fetched;
+				numMissing = countMissing(req, stepPoints, *orbit);
+			}
+			if (numMissing > 0) {
+				evaluateOrbit(key, missingPoints.data(), numMissing, *orbit);
+				shared.share(key, *orbit);
+			}
+		}
+
+		for (int r=0;r<req.steps;r++) {
+			float v = orbit->val[stepPoints[r]];
+			row[r] = req.invert ? -v : v;
+		}
+	}
+
+	void generateSequence(const SequenceRequest& req, StepSequence& seq) {
+		if ((int)seqCache.capacity() != seqCacheCapacity) {
+			seqCache.setCapacity(seqCacheCapacity);
+		}
+		if (!req.approximate) {
+			noiseLattice.clear();
+		}
+		seq.val.resize(PORT_MAX_CHANNELS, req.capacity);
+		missingPoints.resize(req.capacity);
+		OrbitKey key;
+
+		// the approximate field is only built for channel 0's seed; channels
+		// on other seeds evaluate the noise exactly
+		for (int c=0;c<req.channels;c++) {
+			key.seed = req.seed[c];
+			key.approximate = req.approximate && req.seed[c] == req.seed[0];
+			key.base = req.base[c];
+			key.variance = req.variance[c];
+			orbitSteps(req, key, seq.val.row(c));
+		}
+		if (req.morph) {
+			seq.valB.resize(1, req.capacity);
+			seq.mixed.resize(PORT_MAX_CHANNELS, req.capacity);
+			key.seed = req.seed[0];
+			key.approximate = req.approximate;
+			key.base = req.baseB;
+			key.variance = req.varianceB;
+			orbitSteps(req, key, seq.valB.row(0));
+		}
+		seqCacheHits = seqCache.hits;
+		seqCacheMisses = seqCache.misses;
+		seq.request = req;
+	}
 
-		for (int r=0;r<16;r++) {
-			curSeqVal[r] = 0;
-			curSeqState[r] = false;
-			displayStepVal[r] = 0.0f;
+	void seqWorkerLoop() {
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(seqWorkerMutex);
+				seqWorkerCv.wait(lock, [this] { return seqWorkerStop || seqRequests.consume(); });
+			}
+			if (seqWorkerStop) break;
+			generateSequence(seqRequests.front(), sequences.back());
+			sequences.publish();
 		}
+	}
 
+	// Taking the mutex after publishing means the worker is either still
+	// before its check, and sees the request, or already waiting, and gets
+	// the notify; it never sleeps through a request.
+	void wakeSeqWorker() {
+		{
+			std::lock_guard<std::mutex> lock(seqWorkerMutex);
+		}
+		seqWorkerCv.notify_one();
+	}
+
+	// swaps in a sequence the worker (or processControls) has published
+	bool takeSequence() {
+		if (!sequences.consume()) return false;
+		curSeqVal = &sequences.front().val;
+		sequenceChanged = true;
+		return true;
 	}
 
 	void onSampleRateChange(const SampleRateChangeEvent& e) override {
 		// guard against divide-by-zero, which can apparently sometimes happen on Windows
 		if (e.sampleRate > 0) {
 			currentDriftAcc = baseDriftAcc / (e.sampleRate / 44100.0f);
+			displayDivider.setDivision(std::max(1, (int)(e.sampleRate / DISPLAY_RATE)));
         } else {
 			currentDriftAcc = baseDriftAcc;
         }
     }
 
+	// Holds a CV reading until it moves at least one step away from the last
+	// accepted value, then snaps it to the step grid, so bit-level noise on a
+	// static CV no longer looks like a new Base/Range.
+	static float settleCV(float v, float last, float step) {
+		if (step <= 0.f) return v;
+		if (std::fabs(v - last) < step) return last;
+		return clamp(std::round(v / step) * step, 1.f, 10.f);
+	}
+
+	// UI thread; the worker resizes the sequences on the next request
+	void setMaxSteps(int n) {
+		maxSteps = clamp(n, 16, (int)StepMask::MAX_STEPS);
+		paramQuantities[STEPS_PARAM]->maxValue = maxSteps;
+		paramQuantities[OFFSET1_PARAM]->maxValue = maxSteps;
+		if (params[STEPS_PARAM].getValue() > maxSteps) params[STEPS_PARAM].setValue(maxSteps);
+		if (params[OFFSET1_PARAM].getValue() > maxSteps) params[OFFSET1_PARAM].setValue(maxSteps);
+	}
+
+	void setControlRate(int rate) {
+		controlRate = clamp(rate, 1, 64);
+		controlDivider.setDivision(controlRate);
+	}
+
+	void publishDisplay() {
+		DisplaySnapshot& snap = displaySnapshots.back();
+		snap.version = ++displayVersion;
+		std::copy(curSeqVal->row(0), curSeqVal->row(0) + steps, snap.stepVal);
+		// per-trigger masks only hold the steps that fired
+		snap.stepMask = filterPerTrigger ? filterMask(0, filter) : curSeqMask[0];
+		snap.steps = steps;
+		snap.filterSteps = filter_steps;
+		snap.euclideanFilter = filterType < 0.5f;
+		snap.curStep = curStep[0];
+		snap.driftPhase = driftAcc[0][0];
+		snap.driftDiv = drift_div;
+		snap.drift = drift;
+		snap.scale = curScale1;
+		snap.canDriftNormal = canDriftNormal;
+		snap.canDriftFiltered = canDriftFiltered;
+		snap.canDriftDrone = canDriftDrone;
+		snap.showRegenRate = showRegenRate;
+		snap.regenPerSecond = regenPerSecond;
+		snap.seed = seed;
+		snap.base = base[0];
+		snap.range = std::log2(variance[0]);
+		displaySnapshots.publish();
+	}
+
 	void onReset(const ResetEvent& e) override {
 		Module::onReset(e);
 		invertVoltage = false;
@@ -150,18 +639,126 @@ struct ORBsqVi : Module {
 		canDriftFiltered = true;
 		canDriftDrone = true;
 		resetResetsDrift = false;
-		curStep = -1;
-		driftAcc = 0.0f;
+		for (int c=0;c<PORT_MAX_CHANNELS;c++) {
+			curStep[c] = -1;
+		}
+		for (int b=0;b<4;b++) {
+			driftAcc[b] = 0.f;
+		}
+		for (int c=0;c<PORT_MAX_CHANNELS;c++) {
+			heldTriggers[c] = 0;
+		}
+		heldTotal = 0;
 	}
 
-	void process(const ProcessArgs& args) override {
-		curSampleRate = args.sampleRate;
+	// ALG filter: positive filters pass steps inside a window around 0 that
+	// widens with the filter, negative ones pass the steps outside it
+	static bool algorithmicPasses(float val, float f) {
+		if (f > 0) {
+			return (val <= f) && (val >= f*-1.0f+0.15f);
+		} else if (f < 0) {
+			float tf = std::abs(f);
+			return !((val <= tf) && (val >= tf*-1.0f+0.15f));
+		}
+		return false;
+	}
+
+	int euclideanFilterSteps(float f) {
+		return (int)floor(clamp(rescale(f,-1.f,1.f,(steps*-1)-1,steps+1),(float)steps*-1,(float)steps));
+	}
 
+	// Steps of channel c that pass filter value f. EUC: positive filters pass
+	// the complement of a (steps - filter)-pulse pattern, negative ones pass
+	// the (steps + filter)-pulse pattern itself; the pattern does not depend
+	// on the step values.
+	StepMask filterMask(int c, float f) {
+		StepMask mask;
+		if (filterType > 0.5f) {
+			mask.clear();
+			const float* val = curSeqVal->row(c);
+			for (int r=0;r<steps;r++) {
+				if (algorithmicPasses(val[r], f)) mask.set(r, true);
+			}
+			return mask;
+		}
+		int current_filter = euclideanFilterSteps(f);
+		if (current_filter > 0) {
+			euclideanPatterns.pattern(euclideanAlgorithm, steps, steps - current_filter, mask);
+			mask.invert(steps);
+		} else {
+			euclideanPatterns.pattern(euclideanAlgorithm, steps, steps + current_filter, mask);
+		}
+		return mask.rotated(steps, (int)floor(filterShift));
+	}
+
+	// Per-trigger mode: the Filter CV as it is at this sample, so only the
+	// step being fired is evaluated, whatever rate the CV moves at.
+	bool stepPassesNow(int c, int step) {
+		float f = filter;
+		if (inputs[FILTER_INPUT].isConnected()) {
+			f = clamp(rescale(inputs[FILTER_INPUT].getVoltage(),0.f,10.f,-1.f,1.f),-1.f,1.f);
+			if ((f > -0.02f) && (f < 0.02f)) f = 0.f;
+		}
+		if (filterType > 0.5f) {
+			return algorithmicPasses(curSeqVal->row(c)[step], f);
+		}
+		// the bit filterMask(c, f) has at step: the pattern is rotated by
+		// the Offset, and inverted for positive filters
+		int current_filter = euclideanFilterSteps(f);
+		int shift = std::max(0, (int)floor(filterShift));
+		int i = (step - shift + steps) % steps;
+		if (current_filter > 0) {
+			return !euclideanPulses.pulse(euclideanAlgorithm, steps, steps - current_filter, i);
+		}
+		return euclideanPulses.pulse(euclideanAlgorithm, steps, steps + current_filter, i);
+	}
+
+	bool expanderAttached() const {
+		return rightExpander.module && rightExpander.module->model == modelORBsqViExpander;
+	}
+
+	// Points curSeqVal at the current sequence's orbit A, or at A blended
+	// towards B step by step once the sequence has B and Morph is above 0.
+	// Only reads cached values, so it can follow Morph at control rate.
+	void applyMorph() {
+		StepSequence& seq = sequences.front();
+		bool blend = false;
+		for (int c=0;c<channels;c++) {
+			lastMorph[c] = morph[c];
+			if (morph[c] > 0.f) blend = true;
+		}
+		if (!seq.request.morph || !blend) {
+			curSeqVal = &seq.val;
+			return;
+		}
+		int count = std::min(std::max(steps, seq.request.steps), seq.val.capacity);
+		const float* b = seq.valB.row(0);
+		for (int c=0;c<channels;c++) {
+			const float* a = seq.val.row(c);
+			float* out = seq.mixed.row(c);
+			float m = morph[c];
+			for (int r=0;r<count;r++) {
+				out[r] = a[r] + (b[r] - a[r]) * m;
+			}
+		}
+		curSeqVal = &seq.mixed;
+	}
+
+	// Reads params and CVs, detects changes and rebuilds step state. Runs on
+	// controlDivider, on every trigger, and right away when a new sequence is
+	// swapped in so the filter never lags the values; triggers, resets and
+	// outputs stay sample-accurate.
+	void processControls() {
 		bool dirty = false;
 
-		steps = params[STEPS_PARAM].getValue();
-		driftAcc += (currentDriftAcc * params[DRIFTSPEED_PARAM].getValue());
-		if (driftAcc >= TWO_PI) driftAcc = 0.f;
+		int wantSteps = clamp((int)params[STEPS_PARAM].getValue(), 2, maxSteps);
+		// until the worker delivers a longer orbit, play the steps the
+		// current sequence holds, and never more than its storage (a patch
+		// loaded with a long maxSteps starts out with 16)
+		int haveSteps = sequences.front().request.steps;
+		steps = std::min(haveSteps > 0 ? std::min(wantSteps, haveSteps) : wantSteps, curSeqVal->capacity);
+		driftSpeed = params[DRIFTSPEED_PARAM].getValue();
+		voltScale = params[VOLTSCALE_PARAM].getValue();
 
 		curScale1 = params[AMP_PARAM].getValue();
 		if (invertTrigger.process(params[INVERT_PARAM].getValue() > 0.f)) {
@@ -169,20 +766,37 @@ struct ORBsqVi : Module {
 			dirty = true;
         }
 	
-		base = params[POSITION_PARAM].getValue();
-		variance = std::pow(2,(float)params[VARIANCE_PARAM].getValue());
+		channels = std::max(1, std::max(inputs[TRIGGER_INPUT].getChannels(), std::max(inputs[POS_INPUT].getChannels(), inputs[VAR_INPUT].getChannels())));
+		// triggers held on channels that went away are dropped
+		for (int c=channels;c<PORT_MAX_CHANNELS && heldTotal > 0;c++) {
+			heldTotal -= heldTriggers[c];
+			heldTriggers[c] = 0;
+		}
+		float paramBase = params[POSITION_PARAM].getValue();
+		float paramVariance = std::pow(2,(float)params[VARIANCE_PARAM].getValue());
 		drift = params[DRIFT_PARAM].getValue();
 		filterType = params[FILTERTYPE_PARAM].getValue();
 		filterShift = clamp(params[OFFSET1_PARAM].getValue(),0.f,(float)steps-1.f);
 
+		float cvStep = cvResolutionSteps[cvResolution];
+		for (int c=0;c<channels;c++) {
+			base[c] = paramBase;
+			variance[c] = paramVariance;
+			if (inputs[POS_INPUT].isConnected()) {
+				posCV[c] = settleCV(clamp(inputs[POS_INPUT].getPolyVoltage(c),1.f,10.f), posCV[c], cvStep);
+				base[c] = posCV[c];
+			}
+			if (inputs[VAR_INPUT].isConnected()) {
+				varCV[c] = settleCV(clamp(inputs[VAR_INPUT].getPolyVoltage(c),1.f,10.f), varCV[c], cvStep);
+				variance[c] = std::pow(2,varCV[c]);
+			}
+		}
+		// the sliders follow the first channel
 		if (inputs[POS_INPUT].isConnected()) {
-			base = clamp(inputs[POS_INPUT].getVoltage(),1.f,10.f);
-			params[POSITION_PARAM].setValue(base);
+			params[POSITION_PARAM].setValue(base[0]);
 		}
-
 		if (inputs[VAR_INPUT].isConnected()) {
-			variance = std::pow(2,clamp(inputs[VAR_INPUT].getVoltage(),1.f,10.f));
-			params[VARIANCE_PARAM].setValue(clamp(inputs[VAR_INPUT].getVoltage(),1.f,10.f));
+			params[VARIANCE_PARAM].setValue(varCV[0]);
 		}
 
 		if (inputs[DRFT_INPUT].isConnected()) {
@@ -211,176 +825,306 @@ struct ORBsqVi : Module {
 			drift_div = TWO_PI/(float)steps;
 		}
 
-		if ( (base != lastPos) || (variance != lastVar) || (steps != lastSteps) || dirty ) {
-			// recalc ramps
-			float cStep = TWO_PI / steps;
-			float ang = 0.0f;
-			float curVal = 0.0f;
-			for (int r=0;r<steps;r++) {
-				curVal = clamp(simplexNoise.Evaluate((float)base + std::sin(ang) * (variance/50.f), (float)base + std::cos(ang)*(variance/50.f), seed*10.f),-1.0f,1.0f);
-				if (invertVoltage) curVal *= -1.0f;
-				curSeqVal[r] = curVal;
-				ang += cStep;
-				displayStepVal[r] = curVal;
+		baseB = params[BASEB_PARAM].getValue();
+		varianceB = std::pow(2,(float)params[RANGEB_PARAM].getValue());
+		// Seed and Morph CV come from the expander's inputs
+		const ORBsqViControls* controls = expanderAttached() ? (const ORBsqViControls*)rightExpander.consumerMessage : NULL;
+		int paramSeed = (int)params[SEED_PARAM].getValue();
+		bool seedCV = controls && controls->seedChannels > 0;
+		for (int c=0;c<channels;c++) {
+			seeds[c] = paramSeed;
+			if (seedCV) {
+				// 10 seeds per volt on top of the slider
+				float v = controls->seed[controls->seedChannels == 1 ? 0 : c];
+				seeds[c] = clamp(paramSeed + (int)std::round(v * 10.f), 0, 999);
 			}
-			lastPos = base;
-			lastVar = variance;
-			lastSteps = steps;
-			dirty = true;
 		}
+		seed = seeds[0];
+
+		bool morphCV = controls && controls->morphChannels > 0;
+		for (int c=0;c<channels;c++) {
+			morph[c] = params[MORPH_PARAM].getValue();
+			if (morphCV) {
+				float v = controls->morph[controls->morphChannels == 1 ? 0 : c];
+				morph[c] = clamp(rescale(v,0.f,10.f,0.f,1.f),0.f,1.f);
+			}
+		}
+		if (morphCV) {
+			params[MORPH_PARAM].setValue(morph[0]);
+		}
+		morphWanted = morphCV || (params[MORPH_PARAM].getValue() > 0.f);
 
-		if ((filter != lastFilter) || (filterType != oldFilterType) || (filterShift != oldFilterShift) || dirty) {
-			if (filterType > 0.5f) {
-				for (int r=0;r<steps;r++) {
-					if (filter > 0) {
-						if ((curSeqVal[r] <= filter) && (curSeqVal[r] >= filter*-1.0f+0.15f)) {
-							curSeqState[r] = true;
-						} else {
-							curSeqState[r] = false;
-						}
-					} else if (filter < 0) {
-						float tf = std::abs(filter);
-						if ((curSeqVal[r] <= tf) && (curSeqVal[r] >= tf*-1.0f+0.15f)) {
-							curSeqState[r] = false;
-						} else {
-							curSeqState[r] = true;
-						}
-					} else {
-						curSeqState[r] = false;
-					}
+		bool orbitChanged = (channels != lastChannels) || (wantSteps != lastSteps) || (maxSteps != lastMaxSteps) || (invertVoltage != lastInvert) || (useNoiseLattice != lastApproximate);
+		if ((morphWanted != lastMorphWanted) || (morphWanted && ((baseB != lastBaseB) || (varianceB != lastVarB)))) orbitChanged = true;
+		for (int c=0;c<channels;c++) {
+			if ((base[c] != lastPos[c]) || (variance[c] != lastVar[c]) || (seeds[c] != lastSeeds[c])) orbitChanged = true;
+		}
 
-				}
+		if (orbitChanged) {
+			// ask the worker to recalc ramps
+			SequenceRequest& req = seqRequests.back();
+			for (int c=0;c<channels;c++) {
+				req.base[c] = base[c];
+				req.variance[c] = variance[c];
+				req.seed[c] = seeds[c];
+				lastPos[c] = base[c];
+				lastVar[c] = variance[c];
+				lastSeeds[c] = seeds[c];
+			}
+			req.channels = channels;
+			req.steps = wantSteps;
+			req.capacity = maxSteps;
+			req.invert = invertVoltage;
+			req.approximate = useNoiseLattice;
+			req.morph = morphWanted;
+			req.baseB = baseB;
+			req.varianceB = varianceB;
+			req.id = ++requestId;
+			if (synchronousSequences) {
+				generateSequence(req, sequences.back());
+				sequences.publish();
 			} else {
-				// euclidean
-				int current_filter = (int)floor(clamp(rescale(filter,-1.f,1.f,(steps*-1)-1,steps+1),(float)steps*-1,(float)steps));
-				filter_steps = current_filter;
-				if (current_filter == 0) {
-					for (int i=0;i<steps;i++) {
-						curSeqState[i] = false;
-					}
-				}
-				if (current_filter > 0) {
-					if (current_filter == steps) {
-						for (int i=0;i<steps;i++) {
-							curSeqState[i] = true;
-						}
-					} else {
-						int num_pulses = steps - current_filter;
-						// simple
-						for (int i=0;i<steps;i++) {
-							curSeqState[(i+(int)floor(filterShift))%steps] = !((((num_pulses * (i + 0)) % steps) + num_pulses) >= steps);
-						}
-					}
-				} else {
-					// negative euclidean
-					if (abs(current_filter) == steps) {
-						for (int i=0;i<steps;i++) {
-							curSeqState[i] = false;
-						}
-					} else {
-						int num_pulses = steps - abs(current_filter);
-						// euclidian here since we have our own algo
-
-						// simple
-						for (int i=0;i<steps;i++) {
-							curSeqState[(i+(int)floor(filterShift))%steps] = ((((num_pulses * (i + 0)) % steps) + num_pulses) >= steps);
-						}
-					}
-				
-				}
-            }
+				seqRequests.publish();
+				wakeSeqWorker();
+			}
+			lastChannels = channels;
+			lastSteps = wantSteps;
+			lastMaxSteps = maxSteps;
+			lastInvert = invertVoltage;
+			lastApproximate = useNoiseLattice;
+			lastMorphWanted = morphWanted;
+			lastBaseB = baseB;
+			lastVarB = varianceB;
+		}
+
+		bool morphMoved = false;
+		for (int c=0;c<channels;c++) {
+			if (morph[c] != lastMorph[c]) morphMoved = true;
+		}
+		if (morphMoved) {
+			applyMorph();
+			dirty = true;
+			busChanged = true;
+		}
+
+		if (sequenceChanged) {
+			applyMorph();
+			// new ramps were swapped in; refilter
+			sequenceChanged = false;
+			dirty = true;
+			busChanged = true;
+		}
+
+		if (filterType < 0.5f) {
+			filter_steps = euclideanFilterSteps(filter);
+		}
+
+		// per-trigger mode evaluates steps as they fire and leaves the masks
+		// alone; they are rebuilt once when it is switched off
+		if (!filterPerTrigger && ((filter != lastFilter) || (filterType != oldFilterType) || (filterShift != oldFilterShift) || (euclideanAlgorithm != oldEuclideanAlgorithm) || lastFilterPerTrigger || dirty)) {
+			for (int c=0;c<channels;c++) {
+				curSeqMask[c] = filterMask(c, filter);
+			}
 			oldFilterType = filterType;
 			oldFilterShift = filterShift;
+			oldEuclideanAlgorithm = euclideanAlgorithm;
 			lastFilter = filter;
 			dirty = false;
+			busChanged = true;
+		}
+		lastFilterPerTrigger = filterPerTrigger;
+
+		if ((curScale1 != busScale) || (voltScale != busVoltScale) || (canDriftNormal != busCanDriftNormal) || (canDriftFiltered != busCanDriftFiltered)) {
+			busScale = curScale1;
+			busVoltScale = voltScale;
+			busCanDriftNormal = canDriftNormal;
+			busCanDriftFiltered = canDriftFiltered;
+			busChanged = true;
 		}
 
-		if (inReset.process(inputs[RESET_INPUT].getVoltage(), 0.01f, 2.f)) {
-			curStep = -1;
-			if (resetResetsDrift) {
-				driftAcc = 0.0f;
-            }
-		}
-
-		if (inTrigger.process(inputs[TRIGGER_INPUT].getVoltage(), 0.01f, 2.f)) {
-			delayCount = 0;
-			triggered = true;
-		}
-
-		if (triggered) {
-			curStep++;
-			curStep %= steps;
-
-			curVolt = curSeqVal[curStep];
-			droneVolt = curVolt;
-			if (curSeqState[curStep]) {
-				// normal unfiltered note
-				if (canDriftNormal) {
-					curVolt += std::sin(driftAcc + (curStep*drift_div)) * drift;
-                }
-            } else {
-				// filtered note... drift filtered?
-				if (canDriftFiltered) {
-					curVolt += std::sin(driftAcc + (curStep*drift_div)) * drift;
-                }
-            }
-			if (canDriftDrone) {
-				droneVolt += std::sin(driftAcc + (curStep*drift_div)) * drift;
-            }
-			curVolt *= curScale1;
-			droneVolt *= curScale1;
-
-			if (curVolt > 5.f) {
-				curVolt = 5.f - (curVolt - 5.f);
-			}
-			if (curVolt < -5.f) {
-				curVolt = -5.f + (std::abs(curVolt) - 5.f);
-			}
-			if (droneVolt > 5.f) {
-				droneVolt = 5.f - (droneVolt - 5.f);
-			}
-			if (droneVolt < -5.f) {
-				droneVolt = -5.f + (std::abs(droneVolt) - 5.f);
-			}
+		lights[INVERT_LIGHT].setBrightness(invertVoltage ? 0.9f : 0.f);
+	}
 
+	void process(const ProcessArgs& args) override {
+		for (int b=0;b<4;b++) {
+			driftAcc[b] += (currentDriftAcc * driftSpeed);
+			driftAcc[b] = simd::ifelse(driftAcc[b] >= TWO_PI, 0.f, driftAcc[b]);
+		}
 
+		regenRateTime += args.sampleTime;
+		if (regenRateTime >= 1.f) {
+			regenPerSecond = regenCount.exchange(0);
+			regenRateTime -= 1.f;
+		}
 
-			if (params[VOLTSCALE_PARAM].getValue() == 2) {
-				curVolt = rescale(curVolt, -5.f, 5.f, 0.f, 5.f);
-				droneVolt = rescale(droneVolt, -5.f, 5.f, 0.f, 5.f);
-			} else if (params[VOLTSCALE_PARAM].getValue() == 1) {
-				curVolt = rescale(curVolt, -5.f, 5.f, 0.f, 10.f);
-				droneVolt = rescale(droneVolt, -5.f, 5.f, 0.f, 10.f);
-			}
+		// new ramps are swapped in before any trigger reads them
+		takeSequence();
 
-			if (curSeqState[curStep]) {
-				pulseOutputMain.trigger(1e-3f);
-				outputs[MAINCV_OUTPUT].setVoltage(curVolt);
-			} else {
-				pulseOutputFiltered.trigger(1e-3f);
-				outputs[FILTERCV_OUTPUT].setVoltage(curVolt);
+		// a trigger always sees the controls of its own sample
+		int triggerBits[4] = {};
+		int triggerBlocks = (channels + 3) / 4;
+		bool triggered = false;
+		for (int b=0;b<triggerBlocks;b++) {
+			triggerBits[b] = simd::movemask(inTrigger[b].process(inputs[TRIGGER_INPUT].getPolyVoltageSimd<float_4>(b * 4), 0.01f, 2.f));
+			if (triggerBits[b]) triggered = true;
+		}
+
+		if (controlDivider.process() || sequenceChanged || triggered) {
+			processControls();
+			// synchronousSequences generate inline
+			if (takeSequence()) processControls();
+		}
+		uint32_t answered = sequences.front().request.id;
+		if (heldTotal == 0) {
+			holdAge = 0;
+			if (triggered) heldFor = requestId;
+		}
+		bool hold = (int32_t)(answered - heldFor) < 0 && holdAge < TRIGGER_HOLD;
+
+		for (int c=0;c<channels;c+=4) {
+			int b = c / 4;
+			int lanes = std::min(4, channels - c);
+
+			float_4 resetMask = inReset[b].process(inputs[RESET_INPUT].getPolyVoltageSimd<float_4>(c), 0.01f, 2.f);
+			int resetBits = simd::movemask(resetMask);
+			if (resetBits) {
+				for (int i=0;i<lanes;i++) {
+					if (resetBits & (1 << i)) curStep[c+i] = -1;
+				}
+				if (resetResetsDrift) {
+					driftAcc[b] = simd::ifelse(resetMask, 0.f, driftAcc[b]);
+				}
 			}
-			if (curStep == 0) {
-				pulseOutputDrone.trigger(1e-3f);
-				outputs[DRONECV_OUTPUT].setVoltage(droneVolt);
+
+			// channels added by processControls have not been read yet
+			int trig = b < triggerBlocks ? triggerBits[b] : simd::movemask(inTrigger[b].process(inputs[TRIGGER_INPUT].getPolyVoltageSimd<float_4>(c), 0.01f, 2.f));
+			int fire = trig;
+			if (heldTotal > 0 || (trig && hold)) {
+				fire = 0;
+				for (int i=0;i<lanes;i++) {
+					int ch = c + i;
+					// a reset drops held triggers
+					if (resetBits & (1 << i)) {
+						heldTotal -= heldTriggers[ch];
+						heldTriggers[ch] = 0;
+					}
+					if (trig & (1 << i)) {
+						heldTriggers[ch]++;
+						heldTotal++;
+					}
+					if (!hold && heldTriggers[ch] > 0) {
+						heldTriggers[ch]--;
+						heldTotal--;
+						fire |= 1 << i;
+					}
+				}
 			}
+			// triggers are sparse, so the step logic runs per triggered lane
+			int mainBits = 0, filteredBits = 0, droneBits = 0;
+			for (int i=0;i<lanes;i++) {
+				if (!(fire & (1 << i))) continue;
+				int ch = c + i;
+				curStep[ch]++;
+				curStep[ch] %= steps;
+				int step = curStep[ch];
+				float phase = driftAcc[b][i];
+
+				float curVolt = curSeqVal->row(ch)[step];
+				float drone = curVolt;
+				float driftOffset = driftOsc.sin(phase + (step*drift_div)) * drift;
+				bool passed;
+				if (filterPerTrigger) {
+					passed = stepPassesNow(ch, step);
+					// keep the mask showing what actually fired
+					if (curSeqMask[ch].test(step) != passed) busChanged = true;
+					curSeqMask[ch].set(step, passed);
+				} else {
+					passed = curSeqMask[ch].test(step);
+				}
+				if (passed) {
+					// normal unfiltered note
+					if (canDriftNormal) {
+						curVolt += driftOffset;
+					}
+				} else {
+					// filtered note... drift filtered?
+					if (canDriftFiltered) {
+						curVolt += driftOffset;
+					}
+				}
+				if (canDriftDrone) {
+					drone += driftOffset;
+				}
+				curVolt = orbsqviOutputVolt(curVolt * curScale1, voltScale);
+				drone = orbsqviOutputVolt(drone * curScale1, voltScale);
 
-			triggered = false;
+				if (passed) {
+					mainBits |= 1 << i;
+					mainVolt[b][i] = curVolt;
+				} else {
+					filteredBits |= 1 << i;
+					filteredVolt[b][i] = curVolt;
+				}
+				if (step == 0) {
+					droneBits |= 1 << i;
+					droneVolt[b][i] = drone;
+				}
+			}
 
+			if (mainBits) pulseOutputMain[b].trigger(simd::movemaskInverse<float_4>(mainBits), 1e-3f);
+			if (filteredBits) pulseOutputFiltered[b].trigger(simd::movemaskInverse<float_4>(filteredBits), 1e-3f);
+			if (droneBits) pulseOutputDrone[b].trigger(simd::movemaskInverse<float_4>(droneBits), 1e-3f);
 
+			outputs[MAINCV_OUTPUT].setVoltageSimd(mainVolt[b], c);
+			outputs[FILTERCV_OUTPUT].setVoltageSimd(filteredVolt[b], c);
+			outputs[DRONECV_OUTPUT].setVoltageSimd(droneVolt[b], c);
+			outputs[MAINTRIG_OUTPUT].setVoltageSimd(simd::ifelse(pulseOutputMain[b].process(args.sampleTime), 10.f, 0.f), c);
+			outputs[FILTERTRIG_OUTPUT].setVoltageSimd(simd::ifelse(pulseOutputFiltered[b].process(args.sampleTime), 10.f, 0.f), c);
+			outputs[DRONETRIG_OUTPUT].setVoltageSimd(simd::ifelse(pulseOutputDrone[b].process(args.sampleTime), 10.f, 0.f), c);
 		}
+		if (heldTotal > 0) holdAge++;
 
-		triggerMain = pulseOutputMain.process(args.sampleTime);
-		outputs[MAINTRIG_OUTPUT].setVoltage(triggerMain ? 10.f : 0.f);
-
-		triggerFiltered = pulseOutputFiltered.process(args.sampleTime);
-		outputs[FILTERTRIG_OUTPUT].setVoltage(triggerFiltered ? 10.f : 0.f);
+		for (int o=0;o<OUTPUTS_LEN;o++) {
+			outputs[o].setChannels(channels);
+		}
 
-		triggerDrone = pulseOutputDrone.process(args.sampleTime);
-		outputs[DRONETRIG_OUTPUT].setVoltage(triggerDrone ? 10.f : 0.f);
+		if (expanderAttached()) {
+			publishBus((ORBsqViBus*)rightExpander.module->leftExpander.producerMessage);
+			rightExpander.module->leftExpander.requestMessageFlip();
+		}
 
-		lights[INVERT_LIGHT].setBrightness(invertVoltage ? 0.9f : 0.f);
+		if (displayDivider.process()) {
+			publishDisplay();
+		}
+	}
 
+	// Fills the expander's producer buffer. The step table is only copied
+	// when that buffer holds an older busVersion.
+	void publishBus(ORBsqViBus* bus) {
+		if (busChanged) {
+			busVersion++;
+			busChanged = false;
+		}
+		if (bus->sequenceVersion != busVersion) {
+			int count = std::min(steps, (int)ORBsqViBus::STEPS);
+			for (int c=0;c<channels;c++) {
+				std::copy(curSeqVal->row(c), curSeqVal->row(c) + count, bus->stepVal[c]);
+				bus->passMask[c] = (uint16_t)curSeqMask[c].word[0];
+			}
+			bus->channels = channels;
+			bus->steps = steps;
+			bus->scale = curScale1;
+			bus->voltScale = voltScale;
+			bus->canDriftNormal = canDriftNormal;
+			bus->canDriftFiltered = canDriftFiltered;
+			bus->sequenceVersion = busVersion;
+		}
+		for (int c=0;c<channels;c++) {
+			bus->curStep[c] = curStep[c];
+			bus->driftPhase[c] = driftAcc[c / 4][c % 4];
+		}
+		bus->driftDiv = drift_div;
+		bus->drift = drift;
 	}
 
 	json_t* dataToJson() override {
@@ -396,6 +1140,30 @@ struct ORBsqVi : Module {
 		json_object_set_new(rootJ, "canDriftDrone", val);
 		val = json_boolean(resetResetsDrift);
 		json_object_set_new(rootJ, "resetResetsDrift", val);
+		val = json_integer(controlRate);
+		json_object_set_new(rootJ, "controlRate", val);
+		val = json_integer(cvResolution);
+		json_object_set_new(rootJ, "cvResolution", val);
+		val = json_boolean(showRegenRate);
+		json_object_set_new(rootJ, "showRegenRate", val);
+		val = json_boolean(showAtlas);
+		json_object_set_new(rootJ, "showAtlas", val);
+		val = json_integer(seqCacheCapacity);
+		json_object_set_new(rootJ, "sequenceCacheSize", val);
+		val = json_boolean(useNoiseLattice);
+		json_object_set_new(rootJ, "useNoiseLattice", val);
+		val = json_integer(euclideanAlgorithm);
+		json_object_set_new(rootJ, "euclideanAlgorithm", val);
+		val = json_boolean(filterPerTrigger);
+		json_object_set_new(rootJ, "filterPerTrigger", val);
+		val = json_integer(maxSteps);
+		json_object_set_new(rootJ, "maxSteps", val);
+		// past 16, Steps and Offset only fit their ranges once maxSteps is
+		// restored, so they are kept here as well
+		val = json_integer((int)params[STEPS_PARAM].getValue());
+		json_object_set_new(rootJ, "steps", val);
+		val = json_integer((int)params[OFFSET1_PARAM].getValue());
+		json_object_set_new(rootJ, "filterOffset", val);
 
 		return rootJ;
 	}
@@ -421,11 +1189,60 @@ struct ORBsqVi : Module {
 		if (val) {
 			resetResetsDrift = json_boolean_value(val);
 		}
+		val = json_object_get(rootJ, "controlRate");
+		if (val) {
+			setControlRate(json_integer_value(val));
+		}
+		// patches from before the option read their CVs exactly, and keep
+		// doing so
+		val = json_object_get(rootJ, "cvResolution");
+		cvResolution = val ? clamp((int)json_integer_value(val), 0, 3) : 0;
+		val = json_object_get(rootJ, "showRegenRate");
+		if (val) {
+			showRegenRate = json_boolean_value(val);
+		}
+		val = json_object_get(rootJ, "showAtlas");
+		if (val) {
+			showAtlas = json_boolean_value(val);
+		}
+		val = json_object_get(rootJ, "sequenceCacheSize");
+		if (val) {
+			seqCacheCapacity = clamp((int)json_integer_value(val), 0, 128);
+		}
+		val = json_object_get(rootJ, "useNoiseLattice");
+		if (val) {
+			useNoiseLattice = json_boolean_value(val);
+		}
+		val = json_object_get(rootJ, "euclideanAlgorithm");
+		if (val) {
+			euclideanAlgorithm = clamp((int)json_integer_value(val), 0, EuclideanPatterns::ALGORITHMS_LEN - 1);
+		}
+		val = json_object_get(rootJ, "filterPerTrigger");
+		if (val) {
+			filterPerTrigger = json_boolean_value(val);
+		}
+		val = json_object_get(rootJ, "maxSteps");
+		if (val) {
+			setMaxSteps(json_integer_value(val));
+			val = json_object_get(rootJ, "steps");
+			if (val) {
+				params[STEPS_PARAM].setValue(clamp((int)json_integer_value(val), 2, maxSteps));
+			}
+			val = json_object_get(rootJ, "filterOffset");
+			if (val) {
+				params[OFFSET1_PARAM].setValue(clamp((int)json_integer_value(val), 0, maxSteps));
+			}
+		}
 	}
 
 };
 
 
+constexpr float ORBsqVi::DISPLAY_RATE;
+constexpr float ORBsqVi::ORBIT_Z;
+constexpr double ORBsqVi::ATLAS_SETTLE_TIME;
+
+
 struct ORBsqViWidget : ModuleWidget {
 	ORBsqViWidget(ORBsqVi* module) {
 		setModule(module);
@@ -499,11 +1316,76 @@ struct ORBsqViWidget : ModuleWidget {
 		ORBsqVi* module = getModule<ORBsqVi>();
 		menu->addChild(new MenuSeparator);
 		menu->addChild(createMenuLabel("ORBsq Vi Options"));
+		// the panel has no room for it; as a param it can still be mapped and
+		// automated
+		ui::Slider* seedSlider = new ui::Slider;
+		seedSlider->quantity = module->paramQuantities[ORBsqVi::SEED_PARAM];
+		seedSlider->box.size.x = 200.f;
+		menu->addChild(seedSlider);
+		menu->addChild(new MenuSeparator);
+		// orbit A is the panel's Base/Range; Morph CV is on the expander
+		menu->addChild(createMenuLabel("Morph from Base/Range (A) to B"));
+		static const int morphParams[] = {ORBsqVi::MORPH_PARAM, ORBsqVi::BASEB_PARAM, ORBsqVi::RANGEB_PARAM};
+		for (int id : morphParams) {
+			ui::Slider* slider = new ui::Slider;
+			slider->quantity = module->paramQuantities[id];
+			slider->box.size.x = 200.f;
+			menu->addChild(slider);
+		}
+		menu->addChild(createMenuItem("Set B to current Base and Range", "", [=]() {
+			module->paramQuantities[ORBsqVi::BASEB_PARAM]->setValue(module->params[ORBsqVi::POSITION_PARAM].getValue());
+			module->paramQuantities[ORBsqVi::RANGEB_PARAM]->setValue(module->params[ORBsqVi::VARIANCE_PARAM].getValue());
+		}));
+		menu->addChild(new MenuSeparator);
 		menu->addChild(createBoolPtrMenuItem("Drift Main Steps", "", &module->canDriftNormal));
 		menu->addChild(createBoolPtrMenuItem("Drift Filtered Steps", "", &module->canDriftFiltered));
 		menu->addChild(createBoolPtrMenuItem("Drift Drone", "", &module->canDriftDrone));
 		menu->addChild(new MenuSeparator);
 		menu->addChild(createBoolPtrMenuItem("Reset also resets Drift", "", &module->resetResetsDrift));
+		menu->addChild(createIndexPtrSubmenuItem("Euclidean algorithm", {"Simple", "Bjorklund"}, &module->euclideanAlgorithm));
+		menu->addChild(createBoolPtrMenuItem("Evaluate Filter CV per trigger", "", &module->filterPerTrigger));
+		static const int stepLimits[] = {16, 32, 64, 128, 256};
+		menu->addChild(createIndexSubmenuItem("Maximum steps", {"16", "32", "64", "128", "256"},
+			[=]() -> size_t {
+				for (size_t i=0;i<5;i++) {
+					if (stepLimits[i] == module->maxSteps) return i;
+				}
+				return (size_t)0;
+			},
+			[=](size_t i) {
+				module->setMaxSteps(stepLimits[i]);
+			}
+		));
+		menu->addChild(new MenuSeparator);
+		static const int controlRates[] = {1, 16, 32, 64};
+		menu->addChild(createIndexSubmenuItem("Parameter/CV update rate", {"Every sample", "Every 16 samples", "Every 32 samples", "Every 64 samples"},
+			[=]() -> size_t {
+				for (size_t i=0;i<4;i++) {
+					if (controlRates[i] == module->controlRate) return i;
+				}
+				return (size_t)0;
+			},
+			[=](size_t i) {
+				module->setControlRate(controlRates[i]);
+			}
+		));
+		menu->addChild(createIndexPtrSubmenuItem("Base/Range CV resolution", {"Exact", "Fine (0.002V)", "Medium (0.01V)", "Coarse (0.05V)"}, &module->cvResolution));
+		menu->addChild(createBoolPtrMenuItem("Show regeneration and redraw rates", "", &module->showRegenRate));
+		menu->addChild(createBoolPtrMenuItem("Show sequence atlas (click to set Base and Range)", "", &module->showAtlas));
+		static const int cacheSizes[] = {0, 8, 32, 128};
+		menu->addChild(createIndexSubmenuItem("Sequence cache size", {"Off", "8 sequences", "32 sequences", "128 sequences"},
+			[=]() -> size_t {
+				for (size_t i=0;i<4;i++) {
+					if (cacheSizes[i] == module->seqCacheCapacity) return i;
+				}
+				return (size_t)0;
+			},
+			[=](size_t i) {
+				module->seqCacheCapacity = cacheSizes[i];
+			}
+		));
+		menu->addChild(createBoolPtrMenuItem("Fast approximate noise (2.5 MB lattice)", "", &module->useNoiseLattice));
+		menu->addChild(createMenuLabel(string::f("Cache: %llu hits, %llu misses, %llu shared points", (unsigned long long)module->seqCacheHits, (unsigned long long)module->seqCacheMisses, (unsigned long long)module->seqSharedPoints)));
 	}
 
 
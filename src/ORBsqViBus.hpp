@@ -0,0 +1,57 @@
+#pragma once
+#include <rack.hpp>
+#include <cmath>
+#include <cstdint>
+
+// What ORBsqVi sends to an ORBsqViExpander on its right through Rack's
+// double-buffered expander messages. The step table is only rewritten into
+// a buffer whose sequenceVersion is behind the module's, so each change is
+// copied once per buffer and an unchanged sequence never; per sample only
+// the playheads and drift phases move. Covers the first STEPS steps.
+struct ORBsqViBus {
+	static const int STEPS = 16;
+
+	uint32_t sequenceVersion = 0;
+	int channels = 0;
+	int steps = 0;
+	// before Amp, as in the sequence
+	float stepVal[rack::PORT_MAX_CHANNELS][STEPS] = {};
+	// bit i set when step i passes the filter
+	uint16_t passMask[rack::PORT_MAX_CHANNELS] = {};
+	float scale = 0.f;
+	float voltScale = 0.f;
+	bool canDriftNormal = true;
+	bool canDriftFiltered = true;
+
+	// rewritten every sample; curStep is -1 before the first trigger
+	int curStep[rack::PORT_MAX_CHANNELS] = {};
+	float driftPhase[rack::PORT_MAX_CHANNELS] = {};
+	float driftDiv = 0.f;
+	float drift = 0.f;
+};
+
+// What an ORBsqViExpander sends back to the ORBsqVi on its left.
+struct ORBsqViControls {
+	// 0 while the input is unpatched
+	int seedChannels = 0;
+	float seed[rack::PORT_MAX_CHANNELS] = {};
+	int morphChannels = 0;
+	float morph[rack::PORT_MAX_CHANNELS] = {};
+};
+
+// Folds an Amp-scaled step back into -5..5V and maps it to the Voltage
+// Scale range, as ORBsqVi's CV outputs do
+inline float orbsqviOutputVolt(float v, float voltScale) {
+	if (v > 5.f) {
+		v = 5.f - (v - 5.f);
+	}
+	if (v < -5.f) {
+		v = -5.f + (std::abs(v) - 5.f);
+	}
+	if (voltScale == 2) {
+		v = rack::math::rescale(v, -5.f, 5.f, 0.f, 5.f);
+	} else if (voltScale == 1) {
+		v = rack::math::rescale(v, -5.f, 5.f, 0.f, 10.f);
+	}
+	return v;
+}
@@ -1,171 +1,453 @@
 #include <rack.hpp>
+#include <cstring>
+#include "StepMask.hpp"
+#include "SequenceAtlas.hpp"
 
 template <class TModule>
 struct ORBsqViDisplay : rack::LedDisplay {
 	TModule* module;
 	rack::Vec displaySize;
-	float ramp[16];
+	static const int MAX_STEPS = StepMask::MAX_STEPS;
+	// narrowest column a step is drawn in; longer orbits are decimated to
+	// fit, each column showing the span of the steps that fall in it
+	static const int MIN_COLUMN_PX = 2;
+	float ramp[MAX_STEPS];
+	bool stepState[MAX_STEPS] = {};
 	int curstep = -1;
 	int steps = 0;
 	int filtersteps = 0;
 	float curScale1 = 0.f;
 	bool euclideanFilter = false;
 	float curDrone = 0.f;
+	bool showRegenRate = false;
+	int regenPerSecond = 0;
+	bool hasSnapshot = false;
+	// atlas view; atlas is null until the module has it for seed
+	bool showAtlas = false;
+	std::shared_ptr<const SequenceAtlas> atlas;
+	int seed = 0;
+	float base = 0.f;
+	float range = 0.f;
+
+	// The contents are rendered into fb only when what they would show
+	// changes, and the cached image is painted on the light layer. Everything
+	// drawn is quantised into a VisibleState; an unchanged state reuses the
+	// last image.
+	struct Contents : rack::TransparentWidget {
+		ORBsqViDisplay* display;
+		void draw(const DrawArgs& args) override {
+			display->drawContents(args);
+		}
+	};
+	struct VisibleState {
+		// 1/8 px of the unzoomed panel
+		int rampY[MAX_STEPS];
+		int droneY;
+		bool stepState[MAX_STEPS];
+		int steps;
+		int filtersteps;
+		bool euclideanFilter;
+		int curstep;
+		bool showRegenRate;
+		int regenPerSecond;
+		int redrawsPerSecond;
+		bool showAtlas;
+		const SequenceAtlas* atlas;
+		int atlasBase;
+		int atlasRange;
+	};
+	rack::FramebufferWidget* fb;
+	Contents* contents;
+	// zeroed as a whole so memcmp() never sees stale padding
+	VisibleState drawnState;
+	int redraws = 0;
+	int redrawsPerSecond = 0;
+	double redrawRateTime = 0.0;
 
 	std::string fontPath = rack::asset::system("res/fonts/ShareTechMono-Regular.ttf");
 
-	void drawLayer(const DrawArgs& args, int layer) override {
+	ORBsqViDisplay() {
+		// fb is kept out of children so the dimmed base layer does not paint it
+		fb = new rack::FramebufferWidget;
+		contents = new Contents;
+		contents->display = this;
+		fb->addChild(contents);
+		std::memset(&drawnState, 0, sizeof(drawnState));
+	}
 
-		if (layer == 1 && module) {
-			if (module->curSampleRate == 0.f) return;
-
-			for (int i=0;i<16;i++) {
-				ramp[i] = module->displayStepVal[i];
-				if (module->curSeqState[i] == true) {
-					if (module->canDriftNormal) {
-						ramp[i] += std::sin(module->driftAcc + (i*module->drift_div)) * module->drift;
-                    }
-                } else {
-					if (module->canDriftFiltered) {
-						ramp[i] += std::sin(module->driftAcc + (i*module->drift_div)) * module->drift;
-                    }
-                }
-				ramp[i] *= module->curScale1;
-				if (ramp[i] > 5.0f) ramp[i] = 5.0f - (ramp[i] - 5.0f);
-				if (ramp[i] < -5.0f) ramp[i] = -5.0f + std::abs(ramp[i] + 5.0f);
+	~ORBsqViDisplay() {
+		delete fb;
+	}
+
+	static int quantiseY(float mm) {
+		return (int)std::round(rack::mm2px(mm) * 8.f);
+	}
+
+	float stepY(float v) const {
+		return rack::math::clamp(rack::math::rescale(v, -5.f, 5.f, displaySize.y-8.f, 2.f),2.f,displaySize.y-8.f);
+	}
+
+	void step() override {
+		if (module) {
+			// only the snapshot published by the engine is read from here on
+			module->displaySnapshots.consume();
+			const typename TModule::DisplaySnapshot& snap = module->displaySnapshots.front();
+			hasSnapshot = snap.version != 0;
+			if (hasSnapshot) {
+				readSnapshot(snap);
 			}
-			curDrone = module->displayStepVal[0];
-			if (module->canDriftDrone) {
-				curDrone += std::sin(module->driftAcc) * module->drift;
+			showAtlas = module->showAtlas;
+			if (showAtlas && hasSnapshot) {
+				module->requestAtlas(seed);
+				atlas = std::atomic_load(&module->atlas);
+				if (atlas && atlas->noiseSeed != TModule::NOISE_SEED_BASE + seed) atlas.reset();
+			} else {
+				atlas.reset();
+			}
+		}
+
+		double now = rack::system::getTime();
+		if (now - redrawRateTime >= 1.0) {
+			redrawsPerSecond = redraws;
+			redraws = 0;
+			redrawRateTime = now;
+		}
+
+		VisibleState state;
+		std::memset(&state, 0, sizeof(state));
+		if (hasSnapshot) {
+			for (int i=0;i<steps;i++) {
+				state.rampY[i] = quantiseY(stepY(ramp[i]));
+				state.stepState[i] = stepState[i];
+			}
+			state.droneY = quantiseY(stepY(curDrone));
+			state.steps = steps;
+			state.filtersteps = filtersteps;
+			state.euclideanFilter = euclideanFilter;
+			state.curstep = curstep;
+			state.showRegenRate = showRegenRate;
+			if (showRegenRate) {
+				state.regenPerSecond = regenPerSecond;
+				state.redrawsPerSecond = redrawsPerSecond;
+			}
+			state.showAtlas = showAtlas;
+			if (showAtlas) {
+				state.atlas = atlas.get();
+				state.atlasBase = SequenceAtlas::cellAt(base, SequenceAtlas::BASE_CELLS);
+				state.atlasRange = SequenceAtlas::cellAt(range, SequenceAtlas::RANGE_CELLS);
+			}
+		}
+		if (std::memcmp(&state, &drawnState, sizeof(state)) != 0) {
+			drawnState = state;
+			fb->setDirty();
+		}
+
+		fb->box.size = box.size;
+		contents->box.size = box.size;
+		fb->step();
+		LedDisplay::step();
+	}
+
+	void readSnapshot(const typename TModule::DisplaySnapshot& snap) {
+		float driftOffset[MAX_STEPS];
+		int count = rack::math::clamp(snap.steps, 1, (int)MAX_STEPS);
+		module->driftOsc.offsets(snap.driftPhase, snap.driftDiv, count, driftOffset);
+		for (int i=0;i<count;i++) {
+			ramp[i] = snap.stepVal[i];
+			stepState[i] = snap.stepMask.test(i);
+			if (stepState[i] == true) {
+				if (snap.canDriftNormal) {
+					ramp[i] += driftOffset[i] * snap.drift;
+                }
+            } else {
+				if (snap.canDriftFiltered) {
+					ramp[i] += driftOffset[i] * snap.drift;
+                }
             }
-			curDrone *= module->curScale1;
-			if (curDrone > 5.0f) curDrone = 5.0f - (curDrone - 5.0f);
-			if (curDrone < -5.0f) curDrone = -5.0f + std::abs(curDrone + 5.0f);
+			ramp[i] *= snap.scale;
+			if (ramp[i] > 5.0f) ramp[i] = 5.0f - (ramp[i] - 5.0f);
+			if (ramp[i] < -5.0f) ramp[i] = -5.0f + std::abs(ramp[i] + 5.0f);
+		}
+		curDrone = snap.stepVal[0];
+		if (snap.canDriftDrone) {
+			curDrone += driftOffset[0] * snap.drift;
+        }
+		curDrone *= snap.scale;
+		if (curDrone > 5.0f) curDrone = 5.0f - (curDrone - 5.0f);
+		if (curDrone < -5.0f) curDrone = -5.0f + std::abs(curDrone + 5.0f);
 
-			curScale1 = module->curScale1;
-			steps = module->steps;
-			filtersteps = module->filter_steps;
-			euclideanFilter = module->filterType < 0.5f;
-			curstep = module->curStep;
+		curScale1 = snap.scale;
+		steps = count;
+		filtersteps = snap.filterSteps;
+		euclideanFilter = snap.euclideanFilter;
+		curstep = snap.curStep;
+		showRegenRate = snap.showRegenRate;
+		regenPerSecond = snap.regenPerSecond;
+		seed = snap.seed;
+		base = snap.base;
+		range = snap.range;
+	}
 
-			rack::Vec p;
+	// fb is not a child, so the events it frees and rebuilds its NanoVG
+	// framebuffer on have to be passed on by hand
+	void onContextCreate(const ContextCreateEvent& e) override {
+		LedDisplay::onContextCreate(e);
+		fb->onContextCreate(e);
+	}
 
-			// Draw steps
+	void onContextDestroy(const ContextDestroyEvent& e) override {
+		LedDisplay::onContextDestroy(e);
+		fb->onContextDestroy(e);
+	}
 
-			nvgScissor(args.vg, RECT_ARGS(args.clipBox));
-			nvgBeginPath(args.vg);
+	void onDirty(const DirtyEvent& e) override {
+		LedDisplay::onDirty(e);
+		fb->onDirty(e);
+	}
 
-			float stepX = (displaySize.x-2) / (float)steps;
+	void drawLayer(const DrawArgs& args, int layer) override {
+		if (layer == 1 && module && hasSnapshot) {
+			fb->draw(args);
+		}
+		Widget::drawLayer(args, layer);
+	}
 
-			// bottom line
-			p.x = rack::mm2px(1);
-			p.y = rack::mm2px(displaySize.y-6);
-			nvgMoveTo(args.vg, VEC_ARGS(p));
-			p.x = rack::mm2px(displaySize.x - 1);
-			nvgLineTo(args.vg, VEC_ARGS(p));
-			nvgLineCap(args.vg, NVG_ROUND);
-			nvgMiterLimit(args.vg, 2.f);
-			nvgStrokeWidth(args.vg, 1.5f);
-			nvgStrokeColor(args.vg, nvgRGB(0x80,0x80,0x80));
-			nvgStroke(args.vg);
+	// renders into fb; runs only when the visible state changed
+	void drawContents(const DrawArgs& args) {
+		if (!hasSnapshot) return;
+		redraws++;
 
-			// middle line
-			nvgBeginPath(args.vg);
-			p.x = rack::mm2px(1);
-			p.y = rack::mm2px((2.0f+(displaySize.y-8.f)) / 2.f);
-			nvgMoveTo(args.vg, VEC_ARGS(p));
-			p.x = rack::mm2px(displaySize.x-1);
-			nvgLineTo(args.vg, VEC_ARGS(p));
+		if (showAtlas) {
+			drawAtlas(args);
+			return;
+		}
 
-			nvgLineCap(args.vg, NVG_ROUND);
-			nvgMiterLimit(args.vg, 2.f);
-			nvgStrokeWidth(args.vg, 1.5f);
-			nvgStrokeColor(args.vg, nvgRGB(0x30,0x30,0x30));
-			nvgStroke(args.vg);
+		rack::Vec p;
+
+		// Draw steps
+
+		nvgScissor(args.vg, RECT_ARGS(args.clipBox));
+		nvgBeginPath(args.vg);
+
+		float stepX = (displaySize.x-2) / (float)steps;
+
+		// bottom line
+		p.x = rack::mm2px(1);
+		p.y = rack::mm2px(displaySize.y-6);
+		nvgMoveTo(args.vg, VEC_ARGS(p));
+		p.x = rack::mm2px(displaySize.x - 1);
+		nvgLineTo(args.vg, VEC_ARGS(p));
+		nvgLineCap(args.vg, NVG_ROUND);
+		nvgMiterLimit(args.vg, 2.f);
+		nvgStrokeWidth(args.vg, 1.5f);
+		nvgStrokeColor(args.vg, nvgRGB(0x80,0x80,0x80));
+		nvgStroke(args.vg);
+
+		// middle line
+		nvgBeginPath(args.vg);
+		p.x = rack::mm2px(1);
+		p.y = rack::mm2px((2.0f+(displaySize.y-8.f)) / 2.f);
+		nvgMoveTo(args.vg, VEC_ARGS(p));
+		p.x = rack::mm2px(displaySize.x-1);
+		nvgLineTo(args.vg, VEC_ARGS(p));
+
+		nvgLineCap(args.vg, NVG_ROUND);
+		nvgMiterLimit(args.vg, 2.f);
+		nvgStrokeWidth(args.vg, 1.5f);
+		nvgStrokeColor(args.vg, nvgRGB(0x30,0x30,0x30));
+		nvgStroke(args.vg);
+
+		// drone
+		nvgBeginPath(args.vg);
+		p.x = rack::mm2px(1);
+		p.y = rack::mm2px(stepY(curDrone));
+		nvgMoveTo(args.vg, VEC_ARGS(p));
+		p.x = rack::mm2px(displaySize.x-1);
+		nvgLineTo(args.vg, VEC_ARGS(p));
+		nvgLineCap(args.vg, NVG_ROUND);
+		nvgMiterLimit(args.vg, 2.f);
+		nvgStrokeWidth(args.vg, 4.f);
+		nvgStrokeColor(args.vg, nvgRGBA(0x10,0xf0,0xd0,0x40));
+		nvgStroke(args.vg);
+
+		// steps
 
-			// drone
+		int columns = std::max(1, (int)(rack::mm2px(displaySize.x-2) / MIN_COLUMN_PX));
+		if (steps > columns) {
+			for (int b=0;b<columns;b++) {
+				int first = b * steps / columns;
+				int last = (b+1) * steps / columns;
+				drawColumn(args, first, last, 1 + first*stepX, 1 + last*stepX);
+			}
+		} else {
+			for (int i=0;i<steps;i++) {
+				if (stepState[i] == true) {
+					nvgBeginPath(args.vg);
+					p.x = rack::mm2px(1 + (i*stepX+2));
+					p.y = rack::mm2px(stepY(ramp[i]));
+					nvgMoveTo(args.vg, VEC_ARGS(p));
+					p.x = rack::mm2px(1 + ((i+1)*stepX)-1);
+					nvgLineTo(args.vg, VEC_ARGS(p));
+					nvgLineCap(args.vg, NVG_BUTT);
+					nvgMiterLimit(args.vg, 2.f);
+					nvgStrokeWidth(args.vg, 3.f);
+					nvgStrokeColor(args.vg, nvgRGB(0xd0,0xd0,0xd0));
+					nvgStroke(args.vg);
+				} else {
+					nvgBeginPath(args.vg);
+					p.x = rack::mm2px(1 + (i*stepX+2));
+					p.y = rack::mm2px(stepY(ramp[i]));
+					nvgMoveTo(args.vg, VEC_ARGS(p));
+					p.x = rack::mm2px(1 + ((i+1)*stepX)-1);
+					nvgLineTo(args.vg, VEC_ARGS(p));
+					nvgLineCap(args.vg, NVG_BUTT);
+					nvgMiterLimit(args.vg, 2.f);
+					nvgStrokeWidth(args.vg, 1.0f);
+					nvgStrokeColor(args.vg, nvgRGBA(0xd0,0xd0,0xd0,0xa0));
+					nvgStroke(args.vg);
+				}
+			}
+		}
+
+		// beat indicator
+
+		if (curstep >= 0) {
 			nvgBeginPath(args.vg);
-			p.x = rack::mm2px(1);
-			p.y = rack::mm2px(rack::math::clamp(rack::math::rescale(curDrone, -5.f, 5.f, displaySize.y-8.f, 2.f),2.f,displaySize.y-8.f));
+
+			// at least a column wide, so long orbits still show where they are
+			float x0 = rack::mm2px(1 + ((curstep)*stepX));
+			float x1 = std::max(rack::mm2px(1 + ((curstep+1)*stepX)), x0 + MIN_COLUMN_PX);
+			p.x = x0;
+			p.y = rack::mm2px(displaySize.y-7);
 			nvgMoveTo(args.vg, VEC_ARGS(p));
-			p.x = rack::mm2px(displaySize.x-1);
+			p.x = x1;
 			nvgLineTo(args.vg, VEC_ARGS(p));
-			nvgLineCap(args.vg, NVG_ROUND);
+
+			nvgLineCap(args.vg, NVG_BUTT);
 			nvgMiterLimit(args.vg, 2.f);
-			nvgStrokeWidth(args.vg, 4.f);
-			nvgStrokeColor(args.vg, nvgRGBA(0x10,0xf0,0xd0,0x40));
+			nvgStrokeWidth(args.vg, 3.f);
+			nvgStrokeColor(args.vg, rack::SCHEME_WHITE);
 			nvgStroke(args.vg);
-		
-			// steps
+		}
 
-			for (int i=0;i<steps;i++) {
-				if (module) {
-					if (module->curSeqState[i] == true) {
-						nvgBeginPath(args.vg);
-						p.x = rack::mm2px(1 + (i*stepX+2));
-						p.y = rack::mm2px(rack::math::clamp(rack::math::rescale(ramp[i], -5.f, 5.f, displaySize.y-8.f, 2.f),2.f,displaySize.y-8.f));
-						nvgMoveTo(args.vg, VEC_ARGS(p));
-						p.x = rack::mm2px(1 + ((i+1)*stepX)-1);
-						nvgLineTo(args.vg, VEC_ARGS(p));
-						nvgLineCap(args.vg, NVG_BUTT);
-						nvgMiterLimit(args.vg, 2.f);
-						nvgStrokeWidth(args.vg, 3.f);
-						nvgStrokeColor(args.vg, nvgRGB(0xd0,0xd0,0xd0));
-						nvgStroke(args.vg);
-					} else {
-						nvgBeginPath(args.vg);
-						p.x = rack::mm2px(1 + (i*stepX+2));
-						p.y = rack::mm2px(rack::math::clamp(rack::math::rescale(ramp[i], -5.f, 5.f, displaySize.y-8.f, 2.f),2.f,displaySize.y-8.f));
-						nvgMoveTo(args.vg, VEC_ARGS(p));
-						p.x = rack::mm2px(1 + ((i+1)*stepX)-1);
-						nvgLineTo(args.vg, VEC_ARGS(p));
-						nvgLineCap(args.vg, NVG_BUTT);
-						nvgMiterLimit(args.vg, 2.f);
-						nvgStrokeWidth(args.vg, 1.0f);
-						nvgStrokeColor(args.vg, nvgRGBA(0xd0,0xd0,0xd0,0xa0));
-						nvgStroke(args.vg);
-                    }
-				}
-			}
+		std::shared_ptr<rack::Font> font = APP->window->loadFont(fontPath);
+		if (font) {
+			nvgFontSize(args.vg, 12);
+			nvgFontFaceId(args.vg, font->handle);
+			nvgFillColor(args.vg, nvgRGB(0xd0,0xd0,0xd0));
+			std::string stepsStr = "Steps:" + std::to_string(steps);
+			nvgTextAlign(args.vg, NVG_ALIGN_LEFT);
+			nvgText(args.vg, rack::mm2px(1.5),rack::mm2px(37.5), stepsStr.c_str(), NULL);
 
-			// beat indicator
+			if (euclideanFilter) {
+				stepsStr = "EuFlt:" + std::to_string(filtersteps);
+				nvgTextAlign(args.vg, NVG_ALIGN_RIGHT);
+				nvgText(args.vg, rack::mm2px(displaySize.x-1),rack::mm2px(37.5), stepsStr.c_str(), NULL);
+			}
 
-			if (curstep >= 0) {
-				nvgBeginPath(args.vg);
+			if (showRegenRate) {
+				stepsStr = "Regen:" + std::to_string(regenPerSecond) + "/s";
+				nvgTextAlign(args.vg, NVG_ALIGN_CENTER);
+				nvgText(args.vg, rack::mm2px(displaySize.x / 2.f),rack::mm2px(37.5), stepsStr.c_str(), NULL);
+				stepsStr = "Redraw:" + std::to_string(redrawsPerSecond) + "/s";
+				nvgText(args.vg, rack::mm2px(displaySize.x / 2.f),rack::mm2px(5.5), stepsStr.c_str(), NULL);
+			}
+		}
 
-				p.x = rack::mm2px(1 + ((curstep)*stepX));
-				p.y = rack::mm2px(displaySize.y-7);
-				nvgMoveTo(args.vg, VEC_ARGS(p));
-				p.x = rack::mm2px(1 + ((curstep+1)*stepX));
-				nvgLineTo(args.vg, VEC_ARGS(p));
+		nvgResetScissor(args.vg);
+	}
 
-				nvgLineCap(args.vg, NVG_BUTT);
-				nvgMiterLimit(args.vg, 2.f);
-				nvgStrokeWidth(args.vg, 3.f);
-				nvgStrokeColor(args.vg, rack::SCHEME_WHITE);
-				nvgStroke(args.vg);
-			}
+	// The atlas area in mm, Base left to right and Range bottom to top, the
+	// same box the steps are drawn in
+	float atlasX0() const { return 1.f; }
+	float atlasX1() const { return displaySize.x - 1.f; }
+	float atlasY0() const { return 2.f; }
+	float atlasY1() const { return displaySize.y - 8.f; }
 
-			std::shared_ptr<rack::Font> font = APP->window->loadFont(fontPath);
-			if (font) {
-				nvgFontSize(args.vg, 12);
-				nvgFontFaceId(args.vg, font->handle);
-				nvgFillColor(args.vg, nvgRGB(0xd0,0xd0,0xd0));
-				std::string stepsStr = "Steps:" + std::to_string(steps);
-				nvgTextAlign(args.vg, NVG_ALIGN_LEFT);
-				nvgText(args.vg, rack::mm2px(1.5),rack::mm2px(37.5), stepsStr.c_str(), NULL);
-
-				if (euclideanFilter) {
-					stepsStr = "EuFlt:" + std::to_string(filtersteps);
-					nvgTextAlign(args.vg, NVG_ALIGN_RIGHT);
-					nvgText(args.vg, rack::mm2px(displaySize.x-1),rack::mm2px(37.5), stepsStr.c_str(), NULL);
+	// Each cell is shaded by how far apart its lowest and highest steps are
+	// at the current Steps, so flat regions are dark and wide melodies bright.
+	// The current Base/Range cell is outlined.
+	void drawAtlas(const DrawArgs& args) {
+		nvgScissor(args.vg, RECT_ARGS(args.clipBox));
+		float cellW = (atlasX1() - atlasX0()) / SequenceAtlas::BASE_CELLS;
+		float cellH = (atlasY1() - atlasY0()) / SequenceAtlas::RANGE_CELLS;
+		int s = rack::math::clamp(steps, 2, (int)SequenceAtlas::MAX_STEPS);
+		if (atlas) {
+			for (int r=0;r<SequenceAtlas::RANGE_CELLS;r++) {
+				float y = atlasY1() - (r+1) * cellH;
+				for (int b=0;b<SequenceAtlas::BASE_CELLS;b++) {
+					const SequenceAtlas::Cell& c = atlas->cell(b, r);
+					float span = (c.hi[s] - c.lo[s]) / 254.f;
+					nvgBeginPath(args.vg);
+					nvgRect(args.vg, rack::mm2px(atlasX0() + b * cellW), rack::mm2px(y), rack::mm2px(cellW) + 0.5f, rack::mm2px(cellH) + 0.5f);
+					nvgFillColor(args.vg, nvgRGBA(0x10,0xf0,0xd0,(unsigned char)(0x10 + span * 0xe0)));
+					nvgFill(args.vg);
 				}
 			}
+
+			int b = SequenceAtlas::cellAt(base, SequenceAtlas::BASE_CELLS);
+			int r = SequenceAtlas::cellAt(range, SequenceAtlas::RANGE_CELLS);
+			nvgBeginPath(args.vg);
+			nvgRect(args.vg, rack::mm2px(atlasX0() + b * cellW) - 1.f, rack::mm2px(atlasY1() - (r+1) * cellH) - 1.f, rack::mm2px(cellW) + 2.f, rack::mm2px(cellH) + 2.f);
+			nvgStrokeWidth(args.vg, 1.f);
+			nvgStrokeColor(args.vg, rack::SCHEME_WHITE);
+			nvgStroke(args.vg);
 		}
 
+		std::shared_ptr<rack::Font> font = APP->window->loadFont(fontPath);
+		if (font) {
+			nvgFontSize(args.vg, 12);
+			nvgFontFaceId(args.vg, font->handle);
+			nvgFillColor(args.vg, nvgRGB(0xd0,0xd0,0xd0));
+			std::string str = "Steps:" + std::to_string(s);
+			nvgTextAlign(args.vg, NVG_ALIGN_LEFT);
+			nvgText(args.vg, rack::mm2px(1.5),rack::mm2px(37.5), str.c_str(), NULL);
+			str = atlas ? "Seed:" + std::to_string(seed) : "Building atlas...";
+			nvgTextAlign(args.vg, NVG_ALIGN_RIGHT);
+			nvgText(args.vg, rack::mm2px(displaySize.x-1),rack::mm2px(37.5), str.c_str(), NULL);
+		}
 
 		nvgResetScissor(args.vg);
-		Widget::drawLayer(args, layer);
+	}
+
+	// clicking the atlas moves Base and Range to the cell under the mouse
+	void onButton(const ButtonEvent& e) override {
+		if (module && showAtlas && atlas && e.action == GLFW_PRESS && e.button == GLFW_MOUSE_BUTTON_LEFT) {
+			float x = (e.pos.x - rack::mm2px(atlasX0())) / rack::mm2px(atlasX1() - atlasX0());
+			float y = (rack::mm2px(atlasY1()) - e.pos.y) / rack::mm2px(atlasY1() - atlasY0());
+			if (x >= 0.f && x < 1.f && y >= 0.f && y < 1.f) {
+				int b = (int)(x * SequenceAtlas::BASE_CELLS);
+				int r = (int)(y * SequenceAtlas::RANGE_CELLS);
+				module->paramQuantities[TModule::POSITION_PARAM]->setValue(SequenceAtlas::paramAt(b, SequenceAtlas::BASE_CELLS));
+				module->paramQuantities[TModule::VARIANCE_PARAM]->setValue(SequenceAtlas::paramAt(r, SequenceAtlas::RANGE_CELLS));
+				e.consume(this);
+				return;
+			}
+		}
+		LedDisplay::onButton(e);
+	}
+
+	// Steps [first, last) in one column from x0 to x1 (mm): a bar over the
+	// range of their values, filtered steps dim and passed steps bright on top.
+	void drawColumn(const DrawArgs& args, int first, int last, float x0, float x1) {
+		for (int pass=0;pass<2;pass++) {
+			float lo = 5.f, hi = -5.f;
+			bool any = false;
+			for (int i=first;i<last;i++) {
+				if (stepState[i] != (pass == 1)) continue;
+				lo = std::min(lo, ramp[i]);
+				hi = std::max(hi, ramp[i]);
+				any = true;
+			}
+			if (!any) continue;
+			float thickness = pass == 1 ? 3.f : 1.f;
+			float top = rack::mm2px(stepY(hi)) - thickness / 2.f;
+			float bottom = rack::mm2px(stepY(lo)) + thickness / 2.f;
+			nvgBeginPath(args.vg);
+			nvgRect(args.vg, rack::mm2px(x0), top, std::max(rack::mm2px(x1) - rack::mm2px(x0) - 1.f, 1.f), bottom - top);
+			nvgFillColor(args.vg, pass == 1 ? nvgRGB(0xd0,0xd0,0xd0) : nvgRGBA(0xd0,0xd0,0xd0,0xa0));
+			nvgFill(args.vg);
+		}
 	}
 
 
@@ -0,0 +1,264 @@
+#include "plugin.hpp"
+#include "ORBsqViBus.hpp"
+#include "DriftOscillator.hpp"
+
+
+// Per-step outputs for an ORBsqVi placed directly on its left. Step gate i
+// is high while step i is playing (by default only when it also passes the
+// filter, so the gates fire with Main Trig); step CV i is step i's voltage
+// as Main CV plays it. Everything arrives in the ORBsqViBus message, and
+// outputs are only rewritten when what they carry changes. Seed and Morph
+// CV go the other way, in an ORBsqViControls message.
+struct ORBsqViExpander : Module {
+	static const int STEPS = ORBsqViBus::STEPS;
+
+	enum ParamId {
+		PARAMS_LEN
+	};
+	enum InputId {
+		MORPH_INPUT,
+		SEED_INPUT,
+		INPUTS_LEN
+	};
+	enum OutputId {
+		ENUMS(GATE_OUTPUT, STEPS),
+		ENUMS(CV_OUTPUT, STEPS),
+		OUTPUTS_LEN
+	};
+	enum LightId {
+		ENUMS(STEP_LIGHT, STEPS),
+		LIGHTS_LEN
+	};
+
+	// leftExpander's producer and consumer buffers
+	ORBsqViBus busMessages[2];
+	bool gatesFollowFilter = true;
+	bool cvDrift = false;
+
+	int64_t busModuleId = -1;
+	// sequenceVersion the outputs were last written for
+	uint32_t outputVersion = 0;
+	bool lastGatesFollowFilter = true;
+	bool lastCvDrift = false;
+	int gateStep[PORT_MAX_CHANNELS];
+	const DriftOscillator& driftOsc = DriftOscillator::get();
+	dsp::ClockDivider lightDivider;
+
+	ORBsqViExpander() {
+		config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
+		for (int i=0;i<STEPS;i++) {
+			configOutput(GATE_OUTPUT + i, string::f("Step %d gate", i + 1));
+			configOutput(CV_OUTPUT + i, string::f("Step %d CV", i + 1));
+		}
+		configInput(SEED_INPUT, "Seed CV, 10 seeds per volt");
+		configInput(MORPH_INPUT, "Morph 0-10v CV");
+		leftExpander.producerMessage = &busMessages[0];
+		leftExpander.consumerMessage = &busMessages[1];
+		lightDivider.setDivision(512);
+		for (int c=0;c<PORT_MAX_CHANNELS;c++) {
+			gateStep[c] = -1;
+		}
+	}
+
+	void disconnect() {
+		for (int o=0;o<OUTPUTS_LEN;o++) {
+			outputs[o].setChannels(0);
+		}
+		for (int i=0;i<STEPS;i++) {
+			lights[STEP_LIGHT + i].setBrightness(0.f);
+		}
+		for (int c=0;c<PORT_MAX_CHANNELS;c++) {
+			gateStep[c] = -1;
+		}
+		busModuleId = -1;
+		outputVersion = 0;
+	}
+
+	bool stepGate(const ORBsqViBus& bus, int c, int step) const {
+		if (step < 0 || step >= std::min(bus.steps, STEPS)) return false;
+		return !gatesFollowFilter || ((bus.passMask[c] >> step) & 1);
+	}
+
+	void writeStepCVs(const ORBsqViBus& bus, bool withDrift) {
+		int count = std::min(bus.steps, STEPS);
+		float driftOffset[STEPS];
+		for (int c=0;c<bus.channels;c++) {
+			if (withDrift) {
+				driftOsc.offsets(bus.driftPhase[c], bus.driftDiv, count, driftOffset);
+			}
+			for (int i=0;i<STEPS;i++) {
+				float v = 0.f;
+				if (i < count) {
+					v = bus.stepVal[c][i];
+					bool passed = (bus.passMask[c] >> i) & 1;
+					if (withDrift && (passed ? bus.canDriftNormal : bus.canDriftFiltered)) {
+						v += driftOffset[i] * bus.drift;
+					}
+					v = orbsqviOutputVolt(v * bus.scale, bus.voltScale);
+				}
+				outputs[CV_OUTPUT + i].setVoltage(v, c);
+			}
+		}
+	}
+
+	void sendControls() {
+		ORBsqViControls* controls = (ORBsqViControls*)leftExpander.module->rightExpander.producerMessage;
+		int seedChannels = inputs[SEED_INPUT].getChannels();
+		controls->seedChannels = seedChannels;
+		for (int c=0;c<PORT_MAX_CHANNELS;c++) {
+			controls->seed[c] = c < seedChannels ? inputs[SEED_INPUT].getVoltage(c) : 0.f;
+		}
+		int morphChannels = inputs[MORPH_INPUT].getChannels();
+		controls->morphChannels = morphChannels;
+		for (int c=0;c<PORT_MAX_CHANNELS;c++) {
+			controls->morph[c] = c < morphChannels ? inputs[MORPH_INPUT].getVoltage(c) : 0.f;
+		}
+		leftExpander.module->rightExpander.requestMessageFlip();
+	}
+
+	void process(const ProcessArgs&) override {
+		if (!leftExpander.module || leftExpander.module->model != modelORBsqVi) {
+			if (busModuleId >= 0) disconnect();
+			return;
+		}
+		if (leftExpander.module->id != busModuleId) {
+			// a different ORBsqVi; its versions mean nothing here
+			disconnect();
+			busModuleId = leftExpander.module->id;
+		}
+		sendControls();
+		const ORBsqViBus& bus = *(const ORBsqViBus*)leftExpander.consumerMessage;
+		if (bus.sequenceVersion == 0) return;
+
+		bool changed = bus.sequenceVersion != outputVersion || gatesFollowFilter != lastGatesFollowFilter || cvDrift != lastCvDrift;
+		if (changed) {
+			for (int o=0;o<OUTPUTS_LEN;o++) {
+				outputs[o].setChannels(bus.channels);
+			}
+			if (!cvDrift) {
+				writeStepCVs(bus, false);
+			}
+			outputVersion = bus.sequenceVersion;
+			lastGatesFollowFilter = gatesFollowFilter;
+			lastCvDrift = cvDrift;
+		}
+		if (cvDrift) {
+			writeStepCVs(bus, true);
+		}
+
+		for (int c=0;c<bus.channels;c++) {
+			int step = bus.curStep[c];
+			if (step == gateStep[c] && !changed) continue;
+			if (gateStep[c] >= 0 && gateStep[c] < STEPS) {
+				outputs[GATE_OUTPUT + gateStep[c]].setVoltage(0.f, c);
+			}
+			if (stepGate(bus, c, step)) {
+				outputs[GATE_OUTPUT + step].setVoltage(10.f, c);
+			}
+			gateStep[c] = step;
+		}
+
+		if (lightDivider.process()) {
+			for (int i=0;i<STEPS;i++) {
+				lights[STEP_LIGHT + i].setBrightness(bus.curStep[0] == i ? 1.f : 0.f);
+			}
+		}
+	}
+
+	json_t* dataToJson() override {
+		json_t* rootJ = json_object();
+		json_object_set_new(rootJ, "gatesFollowFilter", json_boolean(gatesFollowFilter));
+		json_object_set_new(rootJ, "cvDrift", json_boolean(cvDrift));
+		return rootJ;
+	}
+
+	void dataFromJson(json_t* rootJ) override {
+		json_t* val = json_object_get(rootJ, "gatesFollowFilter");
+		if (val) {
+			gatesFollowFilter = json_boolean_value(val);
+		}
+		val = json_object_get(rootJ, "cvDrift");
+		if (val) {
+			cvDrift = json_boolean_value(val);
+		}
+	}
+};
+
+
+// Column headings and step numbers; the panel itself carries no text.
+struct ORBsqViExpanderLabels : TransparentWidget {
+	std::string fontPath = asset::system("res/fonts/ShareTechMono-Regular.ttf");
+
+	void draw(const DrawArgs& args) override {
+		std::shared_ptr<Font> font = APP->window->loadFont(fontPath);
+		if (!font) return;
+		nvgFontSize(args.vg, 9);
+		nvgFontFaceId(args.vg, font->handle);
+		nvgFillColor(args.vg, nvgRGB(0xcc,0xcc,0xcc));
+		nvgTextAlign(args.vg, NVG_ALIGN_CENTER);
+		static const char* headings[] = {"GATE", "CV", "GATE", "CV"};
+		for (int col=0;col<4;col++) {
+			nvgText(args.vg, mm2px(columnX(col)), mm2px(11.5), headings[col], NULL);
+		}
+		nvgFillColor(args.vg, nvgRGB(0x1a,0x1a,0x1a));
+		nvgTextAlign(args.vg, NVG_ALIGN_RIGHT);
+		nvgText(args.vg, mm2px(columnX(1) - 5.f), mm2px(CONTROLS_Y + 1.f), "SEED", NULL);
+		nvgText(args.vg, mm2px(columnX(3) - 5.f), mm2px(CONTROLS_Y + 1.f), "MORPH", NULL);
+		for (int i=0;i<ORBsqViExpander::STEPS;i++) {
+			std::string n = std::to_string(i + 1);
+			nvgText(args.vg, mm2px(columnX(i / 8 * 2) + 4.2f), mm2px(rowY(i % 8) - 4.6f), n.c_str(), NULL);
+		}
+	}
+
+	// the row of Seed and Morph CV inputs
+	static constexpr float CONTROLS_Y = 113.5f;
+
+	static float columnX(int col) {
+		return 6.35f + col * 9.31f;
+	}
+	static float rowY(int row) {
+		return 20.f + row * 11.6f;
+	}
+};
+
+
+struct ORBsqViExpanderWidget : ModuleWidget {
+	ORBsqViExpanderWidget(ORBsqViExpander* module) {
+		setModule(module);
+		setPanel(createPanel(asset::plugin(pluginInstance, "res/ORBsqViExpanderPanel.svg")));
+
+		addChild(createWidget<ScrewSilver>(Vec(RACK_GRID_WIDTH, 0)));
+		addChild(createWidget<ScrewSilver>(Vec(box.size.x - 2 * RACK_GRID_WIDTH, RACK_GRID_HEIGHT - RACK_GRID_WIDTH)));
+
+		ORBsqViExpanderLabels* labels = createWidget<ORBsqViExpanderLabels>(Vec(0, 0));
+		labels->box.size = box.size;
+		addChild(labels);
+
+		// steps 1-8 in the left pair of columns, 9-16 in the right pair
+		for (int i=0;i<ORBsqViExpander::STEPS;i++) {
+			float gateX = ORBsqViExpanderLabels::columnX(i / 8 * 2);
+			float cvX = ORBsqViExpanderLabels::columnX(i / 8 * 2 + 1);
+			float y = ORBsqViExpanderLabels::rowY(i % 8);
+			addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(gateX, y)), module, ORBsqViExpander::GATE_OUTPUT + i));
+			addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(cvX, y)), module, ORBsqViExpander::CV_OUTPUT + i));
+			addChild(createLightCentered<SmallLight<GreenLight>>(mm2px(Vec(gateX - 3.4f, y - 5.4f)), module, ORBsqViExpander::STEP_LIGHT + i));
+		}
+		addInput(createInputCentered<PJ301MPort>(mm2px(Vec(ORBsqViExpanderLabels::columnX(1), ORBsqViExpanderLabels::CONTROLS_Y)), module, ORBsqViExpander::SEED_INPUT));
+		addInput(createInputCentered<PJ301MPort>(mm2px(Vec(ORBsqViExpanderLabels::columnX(3), ORBsqViExpanderLabels::CONTROLS_Y)), module, ORBsqViExpander::MORPH_INPUT));
+	}
+
+	void appendContextMenu(Menu* menu) override {
+		ORBsqViExpander* module = getModule<ORBsqViExpander>();
+
+		menu->addChild(new MenuSeparator);
+		menu->addChild(createMenuLabel("ORBsq Vi Expander Options"));
+		menu->addChild(createBoolPtrMenuItem("Step gates follow Filter", "", &module->gatesFollowFilter));
+		menu->addChild(createBoolPtrMenuItem("Step CVs include Drift", "", &module->cvDrift));
+	}
+};
+
+
+constexpr float ORBsqViExpanderLabels::CONTROLS_Y;
+
+
+Model* modelORBsqViExpander = createModel<ORBsqViExpander, ORBsqViExpanderWidget>("ORBsqViExpander");
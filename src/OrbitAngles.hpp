@@ -0,0 +1,68 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// A sequence of N steps samples its orbit at angles 2*PI*r/N. Reduced to
+// lowest terms, the fractions r/N for every step count from 2 to MAX_STEPS
+// are far fewer distinct angles, and step counts that divide each other
+// share theirs outright (every 8-step angle is also a 16-step angle). Orbits
+// stored per point let any step count reuse what another one evaluated.
+//
+// Points are numbered by denominator, so the points every step count up to
+// N uses are the first points(N): 80 for 16 steps, 19948 for 256.
+struct OrbitAngles {
+	static const int MAX_STEPS = 256;
+
+	std::vector<float> angle;
+
+	static const OrbitAngles& get() {
+		static const OrbitAngles angles;
+		return angles;
+	}
+
+	int points(int maxSteps) const {
+		return pointCount[maxSteps];
+	}
+
+	// index(steps)[step] is the point that step of a steps-long orbit uses
+	const uint16_t* index(int steps) const {
+		return &indices[indexStart[steps]];
+	}
+
+private:
+	std::vector<uint16_t> indices;
+	int indexStart[MAX_STEPS + 1];
+	int pointCount[MAX_STEPS + 1];
+
+	OrbitAngles() {
+		// point[q][p] for p/q in lowest terms
+		std::vector<std::vector<int>> point(MAX_STEPS + 1);
+		pointCount[0] = 0;
+		for (int q=1;q<=MAX_STEPS;q++) {
+			point[q].assign(q, -1);
+			for (int p=0;p<q;p++) {
+				if (gcd(p, q) != 1) continue;
+				point[q][p] = (int)angle.size();
+				angle.push_back((float)(2.0 * M_PI * p / q));
+			}
+			pointCount[q] = (int)angle.size();
+		}
+		for (int steps=0;steps<=MAX_STEPS;steps++) {
+			indexStart[steps] = (int)indices.size();
+			for (int r=0;r<steps;r++) {
+				int g = gcd(r, steps);
+				indices.push_back((uint16_t)point[steps / g][r / g]);
+			}
+		}
+	}
+
+	static int gcd(int a, int b) {
+		while (b) {
+			int t = a % b;
+			a = b;
+			b = t;
+		}
+		return a;
+	}
+};
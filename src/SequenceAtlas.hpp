@@ -0,0 +1,245 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <utility>
+#include <vector>
+#ifndef ARCH_WIN
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "OpenSimplexNoise.hpp"
+#include "OrbitAngles.hpp"
+
+// The sequences of one noise seed over a grid of Base x Range cells, for
+// finding interesting regions without sweeping the knobs. Each cell keeps
+// its orbit's values at the OrbitAngles points of a 16-step orbit, which
+// cover every Steps setting up to 16, plus the lowest and highest step at
+// each of them.
+//
+// Built across all cores with build() and stored with save() as a flat file
+// that load() maps straight back into memory, so reopening a patch shows
+// the atlas at once.
+struct SequenceAtlas {
+	static const int BASE_CELLS = 64;
+	static const int RANGE_CELLS = 64;
+	static const int MAX_STEPS = 16;
+	// OrbitAngles::points(MAX_STEPS)
+	static const int POINTS = 80;
+	static const uint32_t VERSION = 1;
+	static constexpr float MIN_PARAM = 1.f;
+	static constexpr float MAX_PARAM = 10.f;
+
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		int64_t noiseSeed;
+		float z;
+		uint32_t baseCells;
+		uint32_t rangeCells;
+		uint32_t points;
+	};
+	struct Cell {
+		// -127..127 for -1..1, before inversion
+		int8_t point[POINTS];
+		// indexed by Steps
+		int8_t lo[MAX_STEPS + 1];
+		int8_t hi[MAX_STEPS + 1];
+	};
+
+	int64_t noiseSeed = 0;
+	float z = 0.f;
+
+	SequenceAtlas() {}
+	SequenceAtlas(const SequenceAtlas&) = delete;
+	SequenceAtlas& operator=(const SequenceAtlas&) = delete;
+
+	~SequenceAtlas() {
+		unmap();
+	}
+
+	bool isReady() const {
+		return cells != nullptr;
+	}
+
+	// cell at Base column b and Range row r
+	const Cell& cell(int b, int r) const {
+		return cells[r * BASE_CELLS + b];
+	}
+
+	// Base or Range at the centre of cell i
+	static float paramAt(int i, int count) {
+		return MIN_PARAM + (i + 0.5f) * (MAX_PARAM - MIN_PARAM) / count;
+	}
+
+	static int cellAt(float param, int count) {
+		int i = (int)std::floor((param - MIN_PARAM) / (MAX_PARAM - MIN_PARAM) * count);
+		return std::max(0, std::min(count - 1, i));
+	}
+
+	// Evaluates every cell on one thread per core; Range is the Range knob
+	// (the orbit radius is 2^Range / 50) as in ORBsqVi. Returns false if
+	// cancel was raised first.
+	bool build(const OpenSimplexNoiseF& noise, int64_t seed, float sliceZ, const std::atomic<bool>& cancel) {
+		const OrbitAngles& angles = OrbitAngles::get();
+		if (angles.points(MAX_STEPS) != POINTS) return false;
+		unmap();
+		owned.assign(BASE_CELLS * RANGE_CELLS, Cell());
+
+		std::atomic<int> nextRow{0};
+		auto worker = [&]() {
+			float x[POINTS], y[POINTS], out[POINTS];
+			for (int r;(r = nextRow++) < RANGE_CELLS && !cancel;) {
+				float radius = std::pow(2.f, paramAt(r, RANGE_CELLS)) / 50.f;
+				for (int b=0;b<BASE_CELLS;b++) {
+					float base = paramAt(b, BASE_CELLS);
+					for (int p=0;p<POINTS;p++) {
+						x[p] = base + std::sin(angles.angle[p]) * radius;
+						y[p] = base + std::cos(angles.angle[p]) * radius;
+					}
+					noise.EvaluateBatch(x, y, sliceZ, out, POINTS);
+					Cell& c = owned[r * BASE_CELLS + b];
+					for (int p=0;p<POINTS;p++) {
+						c.point[p] = (int8_t)std::lround(std::max(-1.f, std::min(1.f, out[p])) * 127.f);
+					}
+					c.lo[0] = c.hi[0] = c.lo[1] = c.hi[1] = 0;
+					for (int s=2;s<=MAX_STEPS;s++) {
+						const uint16_t* index = angles.index(s);
+						int8_t lo = 127, hi = -127;
+						for (int i=0;i<s;i++) {
+							lo = std::min(lo, c.point[index[i]]);
+							hi = std::max(hi, c.point[index[i]]);
+						}
+						c.lo[s] = lo;
+						c.hi[s] = hi;
+					}
+				}
+			}
+		};
+		int threads = std::max(1, (int)std::thread::hardware_concurrency());
+		std::vector<std::thread> pool;
+		for (int t=1;t<threads;t++) pool.push_back(std::thread(worker));
+		worker();
+		for (std::thread& t : pool) t.join();
+		if (cancel) {
+			std::vector<Cell>().swap(owned);
+			return false;
+		}
+		cells = owned.data();
+		noiseSeed = seed;
+		z = sliceZ;
+		return true;
+	}
+
+	// writes to a temporary file first, so a reader never maps half an atlas
+	bool save(const std::string& path) const {
+		if (!cells) return false;
+		Header h = header(noiseSeed, z);
+		std::string tmp = path + ".tmp";
+		FILE* f = fopen(tmp.c_str(), "wb");
+		if (!f) return false;
+		bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+		ok = ok && fwrite(cells, sizeof(Cell), BASE_CELLS * RANGE_CELLS, f) == (size_t)(BASE_CELLS * RANGE_CELLS);
+		ok = (fclose(f) == 0) && ok;
+		std::remove(path.c_str());
+		if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+			std::remove(tmp.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	// maps an atlas saved for the same noise; false if there is none
+	bool load(const std::string& path, int64_t seed, float sliceZ) {
+		unmap();
+		size_t size = sizeof(Header) + sizeof(Cell) * BASE_CELLS * RANGE_CELLS;
+#ifdef ARCH_WIN
+		FILE* f = fopen(path.c_str(), "rb");
+		if (!f) return false;
+		std::vector<char> data(size);
+		bool ok = fread(data.data(), 1, size, f) == size && fgetc(f) == EOF;
+		fclose(f);
+		if (!ok || !matches(data.data(), seed, sliceZ)) return false;
+		owned.resize(BASE_CELLS * RANGE_CELLS);
+		std::memcpy(owned.data(), data.data() + sizeof(Header), size - sizeof(Header));
+		cells = owned.data();
+#else
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0) return false;
+		struct stat st;
+		void* p = MAP_FAILED;
+		if (fstat(fd, &st) == 0 && (size_t)st.st_size == size) {
+			p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		}
+		close(fd);
+		if (p == MAP_FAILED) return false;
+		if (!matches(p, seed, sliceZ)) {
+			munmap(p, size);
+			return false;
+		}
+		mapping = p;
+		mappingSize = size;
+		cells = (const Cell*)((const char*)p + sizeof(Header));
+#endif
+		noiseSeed = seed;
+		z = sliceZ;
+		return true;
+	}
+
+	// the saved atlases beyond the keep most recently written ones
+	static std::vector<std::string> oldest(const std::vector<std::string>& paths, int keep) {
+		std::vector<std::pair<time_t, std::string>> byTime;
+		for (const std::string& path : paths) {
+			struct stat st;
+			if (stat(path.c_str(), &st) == 0) byTime.push_back(std::make_pair(st.st_mtime, path));
+		}
+		std::sort(byTime.begin(), byTime.end());
+		std::vector<std::string> old;
+		for (size_t i=0;i + keep < byTime.size();i++) {
+			old.push_back(byTime[i].second);
+		}
+		return old;
+	}
+
+private:
+	const Cell* cells = nullptr;
+	// cells live in owned after build(), or in mapping after load()
+	std::vector<Cell> owned;
+	void* mapping = nullptr;
+	size_t mappingSize = 0;
+
+	static Header header(int64_t seed, float sliceZ) {
+		Header h;
+		std::memset(&h, 0, sizeof(h));
+		std::memcpy(h.magic, "ORBA", 4);
+		h.version = VERSION;
+		h.noiseSeed = seed;
+		h.z = sliceZ;
+		h.baseCells = BASE_CELLS;
+		h.rangeCells = RANGE_CELLS;
+		h.points = POINTS;
+		return h;
+	}
+
+	static bool matches(const void* data, int64_t seed, float sliceZ) {
+		Header h = header(seed, sliceZ);
+		return std::memcmp(data, &h, sizeof(h)) == 0;
+	}
+
+	void unmap() {
+#ifndef ARCH_WIN
+		if (mapping) munmap(mapping, mappingSize);
+#endif
+		mapping = nullptr;
+		mappingSize = 0;
+		cells = nullptr;
+		std::vector<Cell>().swap(owned);
+	}
+};
@@ -0,0 +1,129 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "OpenSimplexNoise.hpp"
+#include "LruCache.hpp"
+
+// One orbit of an ORBsqVi channel. Keys are exact: settleCV() already snaps
+// CV-driven values to a grid. Values are stored before inversion.
+struct OrbitKey {
+	float base;
+	float variance;
+	int seed;
+	bool approximate;
+	bool operator==(const OrbitKey& o) const {
+		return base == o.base && variance == o.variance && seed == o.seed && approximate == o.approximate;
+	}
+};
+
+// An orbit's noise values by OrbitAngles point, with a bit per point that
+// has been evaluated.
+struct OrbitPoints {
+	std::vector<float> val;
+	std::vector<uint64_t> evaluated;
+	bool has(int point) const {
+		return (evaluated[point >> 6] >> (point & 63)) & 1;
+	}
+	void mark(int point) {
+		evaluated[point >> 6] |= (uint64_t)1 << (point & 63);
+	}
+	// growing keeps what was evaluated, as points are numbered so that
+	// shorter orbits come first
+	void reserve(int points) {
+		if ((int)val.size() >= points) return;
+		val.resize(points);
+		evaluated.resize((points + 63) / 64, 0);
+	}
+	void clear() {
+		std::fill(evaluated.begin(), evaluated.end(), 0);
+	}
+	// copies the points other has and this lacks, within this orbit's size;
+	// returns how many
+	int merge(const OrbitPoints& other) {
+		int copied = 0;
+		size_t words = std::min(evaluated.size(), other.evaluated.size());
+		for (size_t w=0;w<words;w++) {
+			uint64_t bits = other.evaluated[w] & ~evaluated[w];
+			while (bits) {
+				int point = (int)(w * 64) + __builtin_ctzll(bits);
+				bits &= bits - 1;
+				if (point >= (int)val.size()) break;
+				val[point] = other.val[point];
+				mark(point);
+				copied++;
+			}
+		}
+		return copied;
+	}
+};
+
+// The noise engine for one seed, shared by every ORBsqVi in the process
+// that uses it, along with the orbit points any of them has evaluated. A
+// rack of instances on the same seed builds its permutation tables once,
+// and a scene one instance has visited is a copy for the others.
+//
+// acquire() hands out the live engine for a seed or builds it; it is freed
+// with its last user. Meant for worker threads: acquire() and the result
+// cache lock, and evaluation is const so it needs no lock at all.
+struct SharedNoise {
+	static const int RESULT_CAPACITY = 64;
+
+	const int64_t seed;
+	const OpenSimplexNoiseF noise;
+
+	explicit SharedNoise(int64_t seed) : seed(seed), noise(seed) {
+		results.setCapacity(RESULT_CAPACITY);
+	}
+
+	static std::shared_ptr<SharedNoise> acquire(int64_t seed) {
+		Registry& r = registry();
+		std::lock_guard<std::mutex> lock(r.mutex);
+		for (auto it = r.engines.begin(); it != r.engines.end();) {
+			if (it->second.expired()) it = r.engines.erase(it);
+			else ++it;
+		}
+		std::shared_ptr<SharedNoise> engine = r.engines[seed].lock();
+		if (!engine) {
+			engine = std::make_shared<SharedNoise>(seed);
+			r.engines[seed] = engine;
+		}
+		return engine;
+	}
+
+	// copies the points of key's orbit that another instance evaluated and
+	// orbit lacks; returns how many
+	int fetch(const OrbitKey& key, OrbitPoints& orbit) {
+		std::lock_guard<std::mutex> lock(resultsMutex);
+		OrbitPoints* shared = results.find(key);
+		return shared ? orbit.merge(*shared) : 0;
+	}
+
+	// offers orbit's points to the other instances
+	void share(const OrbitKey& key, const OrbitPoints& orbit) {
+		std::lock_guard<std::mutex> lock(resultsMutex);
+		OrbitPoints* shared = results.find(key);
+		if (!shared) {
+			shared = results.insert(key);
+			shared->clear();
+		}
+		shared->reserve((int)orbit.val.size());
+		shared->merge(orbit);
+	}
+
+private:
+	struct Registry {
+		std::mutex mutex;
+		std::map<int64_t, std::weak_ptr<SharedNoise>> engines;
+	};
+	static Registry& registry() {
+		static Registry r;
+		return r;
+	}
+
+	std::mutex resultsMutex;
+	LruCache<OrbitKey, OrbitPoints> results;
+};
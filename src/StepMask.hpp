@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+
+// One bit per step for orbits of up to MAX_STEPS steps, bit i for step i.
+// Bits at and above the orbit's step count are kept clear.
+struct StepMask {
+	static const int MAX_STEPS = 256;
+	static const int WORDS = MAX_STEPS / 64;
+	uint64_t word[WORDS];
+
+	void clear() {
+		for (int w=0;w<WORDS;w++) word[w] = 0;
+	}
+
+	// the first steps bits set
+	void fill(int steps) {
+		for (int w=0;w<WORDS;w++) {
+			int bits = steps - w * 64;
+			word[w] = bits >= 64 ? ~(uint64_t)0 : bits > 0 ? ((uint64_t)1 << bits) - 1 : 0;
+		}
+	}
+
+	bool test(int i) const {
+		return (word[i >> 6] >> (i & 63)) & 1;
+	}
+
+	void set(int i, bool on) {
+		uint64_t bit = (uint64_t)1 << (i & 63);
+		if (on) {
+			word[i >> 6] |= bit;
+		} else {
+			word[i >> 6] &= ~bit;
+		}
+	}
+
+	// flips the first steps bits
+	void invert(int steps) {
+		StepMask full;
+		full.fill(steps);
+		for (int w=0;w<WORDS;w++) word[w] = ~word[w] & full.word[w];
+	}
+
+	// step i moves to step (i + shift) % steps
+	StepMask rotated(int steps, int shift) const {
+		if (shift <= 0) return *this;
+		StepMask out;
+		if (steps <= 64) {
+			uint64_t full = steps == 64 ? ~(uint64_t)0 : ((uint64_t)1 << steps) - 1;
+			out.clear();
+			out.word[0] = ((word[0] << shift) | (word[0] >> (steps - shift))) & full;
+			return out;
+		}
+		out.clear();
+		for (int i=0;i<steps;i++) {
+			if (test(i)) {
+				int j = i + shift;
+				if (j >= steps) j -= steps;
+				out.set(j, true);
+			}
+		}
+		return out;
+	}
+};
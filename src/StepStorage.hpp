@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Step values of every channel in one block, channel c's steps at row(c).
+// Rows are padded to whole cache lines and each starts on one, so a channel
+// never shares a line with its neighbour and its steps stream contiguously.
+// Sized by resize(), which allocates: call it off the audio thread.
+struct StepStorage {
+	static const int LINE_FLOATS = 64 / sizeof(float);
+
+	int channels = 0;
+	// steps per row
+	int capacity = 0;
+	int stride = 0;
+
+	StepStorage() {}
+	// data points into buffer, so copies would alias the original
+	StepStorage(const StepStorage&) = delete;
+	StepStorage& operator=(const StepStorage&) = delete;
+
+	void resize(int newChannels, int newCapacity) {
+		if (newChannels == channels && newCapacity == capacity) return;
+		channels = newChannels;
+		capacity = newCapacity;
+		stride = (capacity + LINE_FLOATS - 1) / LINE_FLOATS * LINE_FLOATS;
+		buffer.assign((size_t)channels * stride + LINE_FLOATS - 1, 0.f);
+		uintptr_t p = (uintptr_t)buffer.data();
+		data = (float*)((p + 63) & ~(uintptr_t)63);
+	}
+
+	float* row(int c) {
+		return data + (size_t)c * stride;
+	}
+	const float* row(int c) const {
+		return data + (size_t)c * stride;
+	}
+
+private:
+	std::vector<float> buffer;
+	float* data = nullptr;
+};
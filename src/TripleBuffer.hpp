@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+
+// Single-producer / single-consumer triple buffer holding the latest value of
+// T. The producer fills back() and publish()es it; the consumer consume()s to
+// pull the freshest published slot into front(). Both sides only ever swap an
+// index through one atomic, so neither can block or wait on the other.
+template <typename T>
+struct TripleBuffer {
+	T slots[3];
+
+	TripleBuffer() : writeIndex(0), readIndex(1), middle(2) {}
+
+	// producer side
+	T& back() {
+		return slots[writeIndex];
+	}
+	void publish() {
+		writeIndex = middle.exchange(writeIndex | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+	}
+
+	// consumer side; returns true if front() changed
+	bool consume() {
+		if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+		readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & INDEX_MASK;
+		return true;
+	}
+	const T& front() const {
+		return slots[readIndex];
+	}
+	// the consumer may also write into front() until its next consume()
+	T& front() {
+		return slots[readIndex];
+	}
+
+private:
+	static const int INDEX_MASK = 3;
+	static const int FRESH = 4;
+	int writeIndex;
+	int readIndex;
+	std::atomic<int> middle;
+};
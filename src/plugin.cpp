@@ -7,4 +7,5 @@ Plugin* pluginInstance;
 void init(Plugin* p) {
 	pluginInstance = p;
     p->addModel(modelORBsqVi);
+    p->addModel(modelORBsqViExpander);
 }
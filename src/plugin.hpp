@@ -5,3 +5,4 @@ using namespace rack;
 
 extern Plugin* pluginInstance;
 extern Model* modelORBsqVi;
+extern Model* modelORBsqViExpander;